@@ -6,6 +6,7 @@
  *  - RSI
  *  - ParabolicSAR
  *  - Stop loss
+ *  - Indicator pipeline
 */
 
 // QTScript header name definition
@@ -69,12 +70,193 @@ float calcStdDev (float sma, float[] prices)
   return result;
 }
 
+/* Bollinger upper bands calculation
+  @ prototype
+      float calcBollingerUpperBand (float sma, float stdev, float k) 
+  @ params
+      sma: sma float value of the prices in a given array
+      stdev: standard deviation caculated from a given array
+      k: represents the number of standard deviations applied to the Bollinger Bands indicator.
+  @ return
+      bollinger upper band value */
+float calcBollingerUpperBand (float sma, float stdev, float k) 
+{
+  return (sma + (k*stdev));
+}
+
+/* Bollinger upper bands calculation
+  @ prototype
+      float calcBollingerLowerBand (float sma, float stdev, float k) 
+  @ params
+      sma: sma float value of the prices in a given array
+      stdev: standard deviation caculated from a given array
+      k: represents the number of standard deviations applied to the Bollinger Bands indicator.
+  @ return
+      bollinger upper band value */
+float calcBollingerLowerBand (float sma, float stdev, float k) 
+{
+  return (sma - (k*stdev));
+}
+
+/* EMA smoothing multiplier
+  @ prototype
+      float calcEMAMultiplier(integer period)
+  @ params
+      period: EMA period
+  @ return
+      2 / (period + 1) */
+float calcEMAMultiplier(integer period)
+{
+  return 2.0 / toFloat(period + 1);
+}
+
+/* Bar length parsing
+  @ prototype
+      integer barTimeLengthInMinutes(string typeStepSymbol)
+  @ params
+      typeStepSymbol: symbol string to represent time step - format : "number" + "expression letter" (ex: "1m", "3m", "5m", "15m", "1h", "1d", "1w", "1M"...)
+  @ return
+      bar length in minutes */
+integer barTimeLengthInMinutes(string typeStepSymbol)
+{
+  integer length = toInteger(substring(typeStepSymbol, 0, strlength(typeStepSymbol)-1)); // 1m, 5m, 15m, 30min, 1h, 4h, 1d, 1w, 1M
+  string timeUnit = substring(typeStepSymbol, strlength(typeStepSymbol)-1, 1);
+
+  if (timeUnit == "h")
+  {
+    length = length * 60;
+  }
+  if (timeUnit == "d")
+  {
+    length = length * 24 * 60;
+  }
+  if (timeUnit == "w")
+  {
+    length = length * 7 * 24 * 60;
+  }
+  if (timeUnit == "M")
+  {
+    length = length * 305 * 24 * 6; // means length * 30.5 * 24 * 60
+  }
+  return length;
+}
+
+/* Time bar builder
+
+  Aggregates a stream of trades into OHLCV bars aligned to multiples of the bar length (in trade time, not in trade count).
+  A bar is closed by the first trade falling into a later bar interval, intervals without any trade produce no bar.
+  The closed bar is kept in the closedBar* values until the next bar is closed. */
+
+integer barBuilderLength = 60000000;      // bar length in micro seconds
+integer barBuilderOpenTime = -1;          // start time of the bar being built, -1 before the first trade
+float barBuilderOpen = 0.0;
+float barBuilderHigh = 0.0;
+float barBuilderLow = 0.0;
+float barBuilderClose = 0.0;
+float barBuilderVolume = 0.0;
+
+integer closedBarTime = 0;
+float closedBarOpen = 0.0;
+float closedBarHigh = 0.0;
+float closedBarLow = 0.0;
+float closedBarClose = 0.0;
+float closedBarVolume = 0.0;
+
+/* Starting a new bar stream
+  @ prototype
+      void barBuilderReset(integer barLength)
+  @ params
+      barLength: bar length in micro seconds
+  @ return
+      void */
+void barBuilderReset(integer barLength)
+{
+  barBuilderLength = barLength;
+  barBuilderOpenTime = -1;
+}
+
+/* Moving the bar being built to closedBar*
+  @ prototype
+      void closeBuiltBar()
+  @ return
+      void */
+void closeBuiltBar()
+{
+  closedBarTime = barBuilderOpenTime;
+  closedBarOpen = barBuilderOpen;
+  closedBarHigh = barBuilderHigh;
+  closedBarLow = barBuilderLow;
+  closedBarClose = barBuilderClose;
+  closedBarVolume = barBuilderVolume;
+}
+
+/* Adding a trade to the bar being built
+  @ prototype
+      boolean barBuilderAddTrade(integer tradeTime, float price, float amount)
+  @ params
+      tradeTime: the time stamp of the trade
+      price: the trade price
+      amount: the traded amount
+  @ return
+      true: the trade closed the previous bar, its values are in closedBar*
+      false: the trade was added to the current bar */
+boolean barBuilderAddTrade(integer tradeTime, float price, float amount)
+{
+  integer barTime = tradeTime - (tradeTime % barBuilderLength);
+
+  if (barBuilderOpenTime >= 0 && barTime == barBuilderOpenTime)
+  {
+    if (price > barBuilderHigh)
+    {
+      barBuilderHigh = price;
+    }
+    if (price < barBuilderLow)
+    {
+      barBuilderLow = price;
+    }
+    barBuilderClose = price;
+    barBuilderVolume += amount;
+    return false;
+  }
+
+  boolean isClosed = false;
+  if (barBuilderOpenTime >= 0)
+  {
+    closeBuiltBar();
+    isClosed = true;
+  }
+  barBuilderOpenTime = barTime;
+  barBuilderOpen = price;
+  barBuilderHigh = price;
+  barBuilderLow = price;
+  barBuilderClose = price;
+  barBuilderVolume = amount;
+  return isClosed;
+}
+
+/* Closing the bar being built when its time is over, even if no trade came after it
+  @ prototype
+      boolean barBuilderCloseIfDue(integer now)
+  @ params
+      now: the current time stamp
+  @ return
+      true: the bar is closed, its values are in closedBar* and the next trade opens a new bar
+      false: no bar is open or its time isn't over */
+boolean barBuilderCloseIfDue(integer now)
+{
+  if (barBuilderOpenTime < 0 || now < barBuilderOpenTime + barBuilderLength)
+    return false;
+
+  closeBuiltBar();
+  barBuilderOpenTime = -1;
+  return true;
+}
+
 // Global settings for all algos
 string exchangeSetting = "Centrabit";
 string symbolSetting = "LTC/BTC";
-string position = "flat";
-string initOpenPosition = "";    // Must be "long" or "short", it's used to close the opend position when the strategy finished
 float positionVolume = 0.01;
+float unreachablePrice = 1000000000000.0;   // a price no transaction reaches, used for disabled thresholds
 
 // Global trading informations
 float buyTotal = 0.0;
@@ -84,750 +266,5291 @@ integer sellCount = 0;
 
 float lastPrice = 0.0;
 float lastOwnOrderPrice = 0.0;
-transaction lookbackTransactions[];   // Only used in backtestmode, it keeps the lookback transactions in given period
+
+// Only used in backtestmode, the fetched transactions are kept as separated columns because only these fields are tested
+integer tradeTimeColumn[];
+float tradePriceColumn[];
+float tradeAmountColumn[];
+integer tradeColumnsVersion = 0;      // Increased whenever the trade columns change, indexes built over them are rebuilt
+integer backTestCursor = 0;           // Index of the transaction to be tested next in the trade columns
+integer backTestStartIndex = 0;       // Index of the first tested transaction, the ones before it are only used for warming up
+integer backTestEndIndex = 0;         // Index after the last tested transaction
+integer backTestDroppedCount = 0;     // Count of tested transactions already dropped from the columns by the trade stream
 
 // Flags for running algos
 boolean isBollingerBandsRunning = false;
+boolean isMACDRunning = false;
+boolean isRSIRunning = false;
+boolean isSARRunning = false;
+boolean isPipelineRunning = false;
 boolean isBackTestMode = false;
 boolean isStopLossRunning = false;
+boolean isLiveTriggerOutdated = true;     // the live trigger thresholds must be computed again before the next tick
+integer pendingSignalEvent = -1;          // position event of a bar close signal, placed at the next price, -1 if there is none
+float intraBarSellLevel = -1.0;           // a bar strategy sells when the price falls below it before the bar closes, -1.0 if disarmed
+float intraBarBuyLevel = unreachablePrice; // a bar strategy buys when the price rises above it before the bar closes, unreachablePrice if disarmed
+integer tickCoalescingInterval = 0;       // drain interval of the tick coalescing in milliseconds, 0 means every price is handled at once
 
-/* Stop-Loss Ordering algo
-
-  =====================================================================================
+// Backtest replay settings
+integer backTestTradesPerTimerTick = 1;   // transactions tested in one onTimedOut, 0 means all of them at once
+integer backTestStartedAt = 0;            // time stamp of the replay start, used for the speed report
+boolean isBackTestEventSkipping = false;  // jump over the transactions which can't trigger anything
 
-  About Stop-Loss Order (Buy or sell instructions according to predetermined limits):
-  -----------------------------------------------------------------------------------
+/* Position state machine
 
-    A stop-loss order is a type of order used by traders to limit their loss or lock in a profit on an existing position.
-    Traders can control their exposure to risk by placing a stop-loss order.
-    Stop-loss orders are orders with instructions to close out a position by buying or selling a security at the market when it reaches a certain price known as the stop price.
+  The position of a strategy is one integer state made of three parts:
+    position : positionFlat, positionLong or positionShort
+    initOpenSide : the side of the first position opened from flat, only its stop-loss is running
+    stoppedSide : the side stopped by the stop-loss, no position is opened at this side again until the other side is entered
+  state = position + 3 * initOpenSide + 9 * stoppedSide
 
-      - A stop-loss order instructs that a stock be bought or sold when it reaches a specified price known as the stop price.
-      - Once the stop price is met, the stop order becomes a market order and is executed at the next available opportunity.
-      - Stop-loss orders are used to limit loss or lock in profit on existing positions.
-      - They can protect investors with either long or short positions.
-      - A stop-loss order is different from a stop-limit order, the latter of which must execute at a specific price rather than at the market.
-    
-    Traders or investors may choose to use a stop-loss order to limit their losses and protect their profits.
-    By placing a stop-loss order, they can manage risk by exiting a position if the price for their security starts moving in the direction opposite to the position that they've taken.
+  The events move the state along the transition table and return the order to place:
+    sellSignalEvent : entry or reversal to short, refused while the short side is stopped
+    buySignalEvent : entry or reversal to long, refused while the long side is stopped
+    stopLossEvent : stop-out of the initially opened position
+    finalCloseEvent : end of the strategy, the position is flat again and the buy and sell counts are balanced
+  Live trading, backtests and the parameter sweep are all driven by this table. */
 
-    Benefits of Stop-Loss Orders are as follows.
-      - Stop-loss orders are a smart and easy way to manage the risk of loss on a trade.
-      - They can help traders lock in profit.
-      - Every investor can make them a part of their investment strategy.
-      - They add discipline to an investor's short-term trading efforts.
-      - They take emotions out of trading.
-      - They eliminate the need to monitor investments on a daily (or hourly) basis.
+// Positions and sides
+integer positionFlat = 0;
+integer positionLong = 1;
+integer positionShort = 2;
 
-  Usage :
-  -----------------
-    Before buy or sell command, please execute like this,
-      stopLoss(0.1);  // 0.1 is a pip
+// Position events
+integer sellSignalEvent = 0;
+integer buySignalEvent = 1;
+integer stopLossEvent = 2;
+integer finalCloseEvent = 3;
+integer positionEventCount = 4;
 
-  ===================================================================================== */
+// Orders of the transitions
+integer noOrderAction = 0;
+integer sellOrderAction = 1;
+integer buyOrderAction = 2;
+integer balanceOrderAction = 3;
 
-// Stop-loss settings and flags
-float stopLossPip = 0.1;
-float lockedPriceForProfit = 0.0;
-string positionStoppedAt = "";
+integer positionState = 0;               // the flat state
+integer positionTransitionState[];       // [state * positionEventCount + event] is the next state
+integer positionTransitionAction[];      // [state * positionEventCount + event] is the order to place
 
-/* Execute the stop-loss algo
+/* Building the transition table of the position state machine
   @ prototype
-      void stopLoss(float pip)
-  @ params
-      pip: pip setting value
+      void buildPositionTransitions()
   @ return
       void */
-void stopLoss(float pip)
+void buildPositionTransitions()
 {
-  stopLossPip = pip;
-  isStopLossRunning = true;
-}
+  integer emptyIntegers[];
+  integer position;
+  integer initOpenSide;
+  integer stoppedSide;
+  integer state;
 
-/* Determining and excuting the stop-loss order
-  @ prototype
-      string stopLossTick(integer timeStamp, float price)
-  @ params
-      timestamp: the time stamp for the price moment
-      price: the current price
-  @ return
-      "" : didn't stop the position
-      "long" : stopped at long position
-      "short" : stopped at short position */
-string stopLossTick(integer timeStamp, float price)
-{
-  if (sizeof(lookbackTransactions) == 0)
-    return "";
-  if (position == "flat")
-    return "";
-  float limitPrice;
-  float amount;
-  if (position == "long" && initOpenPosition == "long")
+  positionTransitionState = emptyIntegers;
+  positionTransitionAction = emptyIntegers;
+  for (state = 0; state < 27; state++)
   {
-    limitPrice = lastOwnOrderPrice * (1.0 - stopLossPip);
-    if (price < limitPrice)
+    position = state % 3;
+    initOpenSide = (state / 3) % 3;
+    stoppedSide = state / 9;
+
+    // sellSignalEvent
+    if (position != positionShort && stoppedSide != positionShort)
     {
-      if (isBackTestMode == false)
+      if (position == positionFlat)
       {
-        sellMarket(exchangeSetting, symbolSetting, positionVolume, 0);
+        positionTransitionState >> positionShort + 3 * positionShort;
       }
-      drawPoint(timeStamp, price, true, "sell");
-      setLineName("direction");
-      setLineColor("green");
-      drawLine(timeStamp, price); 
-      amount = lookbackTransactions[0].price * positionVolume;
-      sellTotal += amount;
-      sellCount ++;
-      // print(".       sell total is " + toString(sellTotal));
-      position = "flat";
-      print("! Long position closed for stop loss : "+ toString(positionVolume) + "( price- " + toString(price) + ", time- " + timeToString(timeStamp, "yyyy-MM-dd hh:mm:ss") + " )");
-      return "long";
+      else
+      {
+        positionTransitionState >> positionShort + 3 * initOpenSide;
+      }
+      positionTransitionAction >> sellOrderAction;
     }
-  }
-  if (position == "short" && initOpenPosition == "short")
-  {
-    limitPrice = lastOwnOrderPrice * (1.0 + stopLossPip);
-    if (price > limitPrice )
+    else
     {
-      if (isBackTestMode == false)
+      positionTransitionState >> state;
+      positionTransitionAction >> noOrderAction;
+    }
+
+    // buySignalEvent
+    if (position != positionLong && stoppedSide != positionLong)
+    {
+      if (position == positionFlat)
       {
-        buyMarket(exchangeSetting, symbolSetting, positionVolume, 0);
+        positionTransitionState >> positionLong + 3 * positionLong;
       }
-      drawPoint(timeStamp, price, false, "buy");
-      setLineName("direction");
-      setLineColor("green");
-      drawLine(timeStamp, price); 
-      amount = lookbackTransactions[0].price * positionVolume;
-      buyTotal += amount;
-      buyCount ++;  
-      // print(".       buy total is " + toString(buyTotal));
-      position = "flat";
-      print("! Short position closed for stop loss: "+ toString(positionVolume) + "( price- " + toString(price) + ", time- " + timeToString(timeStamp, "yyyy-MM-dd hh:mm:ss") + " )");
-      return "short";
+      else
+      {
+        positionTransitionState >> positionLong + 3 * initOpenSide;
+      }
+      positionTransitionAction >> buyOrderAction;
+    }
+    else
+    {
+      positionTransitionState >> state;
+      positionTransitionAction >> noOrderAction;
+    }
+
+    // stopLossEvent
+    if (position != positionFlat && position == initOpenSide && stoppedSide == positionFlat)
+    {
+      positionTransitionState >> positionFlat + 3 * initOpenSide + 9 * position;
+      if (position == positionLong)
+      {
+        positionTransitionAction >> sellOrderAction;
+      }
+      else
+      {
+        positionTransitionAction >> buyOrderAction;
+      }
+    }
+    else
+    {
+      positionTransitionState >> state;
+      positionTransitionAction >> noOrderAction;
     }
+
+    // finalCloseEvent
+    positionTransitionState >> positionFlat;
+    positionTransitionAction >> balanceOrderAction;
   }
-  return "";
 }
 
-/* Lock in profit
+/* Building the transition table once before a strategy starts
   @ prototype
-      boolean trailingStop(float price)
-  @ params
-      price: the current price
+      void initPositionMachine()
   @ return
-      true: the new profit locked in
-      false: didn't lock any profit */
-boolean trailingStop(float price)
+      void */
+void initPositionMachine()
 {
-  return false;
-  if (isStopLossRunning == false)
-    return false;
-  if (position == "flat" || position == "long")   // if the position is in 
-  {
-    if (lockedPriceForProfit == 0.0 || lockedPriceForProfit < price)
-    {
-      lockedPriceForProfit = price;
-      print("profit locked at " + toString(price) + "for short position");
-      // limitPrice = lastOwnOrderPrice * (1.0 - stopLossPip);
-      return true;
-    }
-  }
-  if (position == "flat" || position == "short")
+  if (sizeof(positionTransitionState) == 0)
   {
-    if (lockedPriceForProfit == 0.0 || lockedPriceForProfit > price)
-    {
-      lockedPriceForProfit = price;
-      print("profit locked at " + toString(price) + "for long position");
-      // limitPrice = lastOwnOrderPrice * (1.0 + stopLossPip);
-      return true;
-    }
+    buildPositionTransitions();
   }
-  lockedPriceForProfit = 0.0;
-  return false;
 }
 
+/* Order of an event in a state, without changing the state
+  @ prototype
+      integer positionActionOf(integer state, integer event)
+  @ params
+      state: the position state
+      event: the position event
+  @ return
+      noOrderAction, sellOrderAction, buyOrderAction or balanceOrderAction */
+integer positionActionOf(integer state, integer event)
+{
+  return positionTransitionAction[state * positionEventCount + event];
+}
 
-/* Bollinger Bands trading strategy
+/* Moving a position state along an event
+  @ prototype
+      integer nextPositionState(integer state, integer event)
+  @ params
+      state: the position state
+      event: the position event
+  @ return
+      the next state */
+integer nextPositionState(integer state, integer event)
+{
+  return positionTransitionState[state * positionEventCount + event];
+}
 
-  =====================================================================================
+/* Position part of a state
+  @ prototype
+      integer positionOf(integer state)
+  @ params
+      state: the position state
+  @ return
+      positionFlat, positionLong or positionShort */
+integer positionOf(integer state)
+{
+  return state % 3;
+}
 
-  About Bollinger Bands Indicator:
-  --------------------------------
+/* Checking that no strategy is running before another one starts
+  The strategies share the live bar builder, the bar boundary scheduler, the backtest cursor and the position,
+  so only one of them runs at once. The indicator pipeline runs several strategies on one feed.
+  @ prototype
+      boolean canStartStrategy(string name)
+  @ params
+      name: name of the strategy to start, printed when it's refused
+  @ return
+      true: no strategy is running
+      false: another strategy is running, the new one must not start */
+boolean canStartStrategy(string name)
+{
+  if (isBollingerBandsRunning == false && isMACDRunning == false && isRSIRunning == false && isSARRunning == false && isPipelineRunning == false)
+    return true;
+  print(name + " isn't started, another strategy is running. Please add the strategies to the indicator pipeline to run them together.");
+  return false;
+}
 
-    Bollinger Bands are a popular technical indicator which use standard deviation to establish where a band of likely support and resistance levels might be found. 
-    A volatility channel plots lines above and below a central measure of price. 
-    These lines, also known as envelopes or bands, widen or contract according to how volatile or non-volatile a market is. 
-    Bollinger Bands measure market volatility and provide lots of useful information, including:
+/* Setting the backtest replay speed
+  By default a backtest tests one transaction per timer tick, so its speed is capped by the timer rate.
+  With the turbo mode a whole slice of transactions is tested in a tight loop in every timer tick.
+  Larger slices are faster, smaller ones keep the UI more responsive.
+  @ prototype
+      void backTestTurbo(integer tradesPerTick)
+  @ params
+      tradesPerTick: transaction count tested in one timer tick, 0 tests all remaining transactions in the first tick
+  @ return
+      void */
+void backTestTurbo(integer tradesPerTick)
+{
+  backTestTradesPerTimerTick = tradesPerTick;
+}
 
-      - Trend continuation or reversal
-      - Periods of market consolidation
-      - Periods of upcoming large volatility breakouts
-      - Possible market tops or bottoms and potential price targets
-    
-    Bollinger Bands consist of three lines, the middle of which is a Simple Moving Average (SMA) with the default value of 20. 
-    The upper and lower band are found two standard deviations either side of the SMA.
+/* Public trades cache
 
-    The most basic interpretation of Bollinger Bands is that the channels represent a measure of 'highness' and 'lowness'. 
-    Let's sum up three key points about Bollinger bands:
+  Keeps the public trades fetched for one exchange/symbol in one continuous time range.
+  When a range is requested again only the sub-ranges before and after the cached one are fetched from the exchange,
+  so repeated backtests over the same window don't wait for getPubTrades again.
+  The cache lives as long as the script is running, fetching another exchange/symbol replaces it.
 
-      - The upper band shows a level that is statistically high or expensive
-      - The lower band shows a level that is statistically low or cheap
-      - The Bollinger Band width correlates to the volatility of the market
-          - In a more volatile market, Bollinger Bands widen
-          - In a less volatile market, the bands narrow
+  The trades are stored in the tradeTimeColumn, tradePriceColumn and tradeAmountColumn arrays,
+  the transaction records returned by getPubTrades are dropped as soon as they are copied into the columns. */
 
-    The Bollinger Bands contain a default setting in Forex trading as (20,2) - 
-    where 20 is the value for the SMA and 2 refers to the number of standard deviations the upper and lower band are either side of the SMA.
+string tradeCacheExchange = "";
+string tradeCacheSymbol = "";
+integer tradeCacheStart = 0;
+integer tradeCacheEnd = 0;      // the cached range is [tradeCacheStart, tradeCacheEnd], both inclusive
+
+/* Appending fetched transactions to the trade columns
+  @ prototype
+      integer appendTradesToColumns(transaction[] transactions, integer timeStart, integer timeEnd)
+  @ params
+      transactions: transactions sorted by tradeTime
+      timeStart: transactions before this time stamp are skipped
+      timeEnd: transactions after this time stamp are skipped
+  @ return
+      count of the appended transactions */
+integer appendTradesToColumns(transaction[] transactions, integer timeStart, integer timeEnd)
+{
+  integer appendedCount = 0;
+  for (integer i = 0; i < sizeof(transactions); i++)
+  {
+    if (transactions[i].tradeTime >= timeStart && transactions[i].tradeTime <= timeEnd)
+    {
+      tradeTimeColumn >> transactions[i].tradeTime;
+      tradePriceColumn >> transactions[i].price;
+      tradeAmountColumn >> transactions[i].amount;
+      appendedCount ++;
+    }
+  }
+  tradeColumnsVersion ++;
+  return appendedCount;
+}
+
+/* Emptying the trade columns
+  @ prototype
+      void clearTradeColumns()
+  @ return
+      void */
+void clearTradeColumns()
+{
+  integer emptyTimes[];
+  float emptyPrices[];
+  float emptyAmounts[];
+  tradeTimeColumn = emptyTimes;
+  tradePriceColumn = emptyPrices;
+  tradeAmountColumn = emptyAmounts;
+  tradeColumnsVersion ++;
+}
+
+/* Loading public trades of a time range through the cache
+  @ prototype
+      void loadPubTrades(string exchange, string symbol, integer timeStart, integer timeEnd)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      timeStart: start time stamp of the range
+      timeEnd: end time stamp of the range
+  @ return
+      void, the trade columns keep all cached transactions of the exchange/symbol, the requested range included */
+void loadPubTrades(string exchange, string symbol, integer timeStart, integer timeEnd)
+{
+  // trades in the future can't be cached yet
+  integer now = getCurrentTime();
+  if (timeEnd > now)
+  {
+    timeEnd = now;
+  }
+
+  if (exchange != tradeCacheExchange || symbol != tradeCacheSymbol || sizeof(tradeTimeColumn) == 0)
+  {
+    clearTradeColumns();
+    appendTradesToColumns(getPubTrades(exchange, symbol, timeStart, timeEnd), timeStart, timeEnd);
+    tradeCacheExchange = exchange;
+    tradeCacheSymbol = symbol;
+    tradeCacheStart = timeStart;
+    tradeCacheEnd = timeEnd;
+    return;
+  }
+
+  integer cachedCount = sizeof(tradeTimeColumn);
+  if (timeStart < tradeCacheStart)
+  {
+    integer cachedTimes[] = tradeTimeColumn;
+    float cachedPrices[] = tradePriceColumn;
+    float cachedAmounts[] = tradeAmountColumn;
+
+    clearTradeColumns();
+    appendTradesToColumns(getPubTrades(exchange, symbol, timeStart, tradeCacheStart), timeStart, tradeCacheStart - 1);
+    for (integer i = 0; i < cachedCount; i++)
+    {
+      tradeTimeColumn >> cachedTimes[i];
+      tradePriceColumn >> cachedPrices[i];
+      tradeAmountColumn >> cachedAmounts[i];
+    }
+    tradeColumnsVersion ++;
+    tradeCacheStart = timeStart;
+  }
+  if (timeEnd > tradeCacheEnd)
+  {
+    appendTradesToColumns(getPubTrades(exchange, symbol, tradeCacheEnd, timeEnd), tradeCacheEnd + 1, timeEnd);
+    tradeCacheEnd = timeEnd;
+  }
+  print("   " + toString(cachedCount) + " of transactions are served from the cache.");
+}
+
+/* Public trades stream
+
+  Instead of loading the whole backtest range before the first tick, the trades can be fetched window by window.
+  When the tested transactions reach the end of the columns, the consumed ones are dropped and the next window is fetched,
+  so the first signals come right away and the memory doesn't depend on the length of the range.
+  The window length adapts itself to keep the fetched transaction count of a window under the memory budget,
+  it grows back on quiet ranges but never beyond the initial length given to backTestStreaming.
+  A window holding more transactions than the budget is halved and fetched again before it's appended,
+  so only a burst denser than the budget in 2 seconds, the shortest window, can go over it.
+
+  Usage :
+  -----------------
+    Before a backtest, please execute like this,
+      backTestStreaming(60, 100000);  // fetch 60 minutes at once, keep up to 100000 transactions in memory */
+
+integer tradeStreamWindowLength = 0;      // window length in micro seconds, 0 disables the streaming
+integer tradeStreamMaxWindowLength = 0;   // the initial window length, the window never grows beyond it
+integer tradeStreamMaxTrades = 100000;    // memory budget in transactions
+string tradeStreamExchange = "";
+string tradeStreamSymbol = "";
+integer tradeStreamNextTime = 0;          // start of the next window to fetch
+integer tradeStreamEndTime = 0;           // end of the streamed range, inclusive
+
+/* Enabling the public trades stream for backtests
+  @ prototype
+      void backTestStreaming(integer windowInMinutes, integer maxTrades)
+  @ params
+      windowInMinutes: initial length of a fetched window in minutes, 0 disables the streaming
+      maxTrades: maximum transaction count to keep in memory
+  @ return
+      void */
+void backTestStreaming(integer windowInMinutes, integer maxTrades)
+{
+  tradeStreamWindowLength = windowInMinutes * 60 * 1000 * 1000;
+  tradeStreamMaxWindowLength = tradeStreamWindowLength;
+  tradeStreamMaxTrades = maxTrades;
+}
+
+/* Starting to stream a time range
+  @ prototype
+      void tradeStreamOpen(string exchange, string symbol, integer timeStart, integer timeEnd)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      timeStart: start time stamp of the streamed range
+      timeEnd: end time stamp of the streamed range
+  @ return
+      void */
+void tradeStreamOpen(string exchange, string symbol, integer timeStart, integer timeEnd)
+{
+  tradeStreamExchange = exchange;
+  tradeStreamSymbol = symbol;
+  tradeStreamNextTime = timeStart;
+  tradeStreamEndTime = timeEnd;
+
+  // the columns don't keep a cached range any more
+  tradeCacheExchange = "";
+}
+
+/* Fetching the next non empty window of the stream into the trade columns
+  @ prototype
+      integer tradeStreamFetchNext()
+  @ return
+      count of appended transactions, 0 when the stream is finished */
+integer tradeStreamFetchNext()
+{
+  integer fetchedCount = 0;
+  integer windowEnd = 0;
+  transaction windowTrades[];
+
+  while (fetchedCount == 0 && tradeStreamNextTime <= tradeStreamEndTime)
+  {
+    windowEnd = tradeStreamNextTime + tradeStreamWindowLength - 1;
+    if (windowEnd > tradeStreamEndTime)
+    {
+      windowEnd = tradeStreamEndTime;
+    }
+    windowTrades = getPubTrades(tradeStreamExchange, tradeStreamSymbol, tradeStreamNextTime, windowEnd);
+
+    // a burst over the memory budget is fetched again with a shorter window
+    if (sizeof(windowTrades) > tradeStreamMaxTrades && tradeStreamWindowLength > 2000000)
+    {
+      tradeStreamWindowLength = tradeStreamWindowLength / 2;
+    }
+    else
+    {
+      fetchedCount = appendTradesToColumns(windowTrades, tradeStreamNextTime, windowEnd);
+      tradeStreamNextTime = windowEnd + 1;
+
+      // keep the next windows in the memory budget
+      if (fetchedCount > tradeStreamMaxTrades / 2 && tradeStreamWindowLength > 2000000)
+      {
+        tradeStreamWindowLength = tradeStreamWindowLength / 2;
+      }
+      // a quiet window doubles the next one, up to the initial length so the next fetch can't blow the budget
+      if (fetchedCount < tradeStreamMaxTrades / 8)
+      {
+        tradeStreamWindowLength = tradeStreamWindowLength * 2;
+        if (tradeStreamWindowLength > tradeStreamMaxWindowLength)
+        {
+          tradeStreamWindowLength = tradeStreamMaxWindowLength;
+        }
+      }
+    }
+  }
+  return fetchedCount;
+}
+
+/* Dropping the tested transactions and fetching the next window when the backtest reached the last loaded transaction
+  @ prototype
+      boolean tradeStreamFill()
+  @ return
+      true: new transactions are loaded after the current one, the cursor is moved to the current one
+      false: the streaming is disabled or finished */
+boolean tradeStreamFill()
+{
+  if (tradeStreamWindowLength == 0 || tradeStreamNextTime > tradeStreamEndTime)
+    return false;
+
+  // only the current transaction is kept
+  integer currentTime = tradeTimeColumn[backTestCursor];
+  float currentPrice = tradePriceColumn[backTestCursor];
+  float currentAmount = tradeAmountColumn[backTestCursor];
+  backTestDroppedCount += backTestCursor - backTestStartIndex;
+
+  clearTradeColumns();
+  tradeTimeColumn >> currentTime;
+  tradePriceColumn >> currentPrice;
+  tradeAmountColumn >> currentAmount;
+  tradeColumnsVersion ++;
+  backTestStartIndex = 0;
+  backTestCursor = 0;
+
+  integer fetchedCount = tradeStreamFetchNext();
+  backTestEndIndex = sizeof(tradeTimeColumn);
+  return (fetchedCount > 0);
+}
+
+/* Searching the first transaction at or after a given time in the trade columns
+  @ prototype
+      integer findTransactionIndexAtTime(integer timestamp)
+  @ params
+      timestamp: the time stamp to search
+  @ return
+      index of the first transaction whose tradeTime is not before the timestamp, sizeof(tradeTimeColumn) if there is none */
+integer findTransactionIndexAtTime(integer timestamp)
+{
+  integer low = 0;
+  integer high = sizeof(tradeTimeColumn);
+  integer middle;
+
+  // binary search, the fetched transactions are sorted by tradeTime
+  while (low < high)
+  {
+    middle = (low + high) / 2;
+    if (tradeTimeColumn[middle] < timestamp)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+/* Skipping the quiet transactions in backtests
+  Most transactions fall between the bands while no stop-loss is near, they don't change anything.
+  With the event skipping the backtest searches the first transaction crossing a band, a stop limit or closing a bar
+  in a segment tree over the trade prices and jumps to it, the results are the same.
+  The band lines are only drawn on the tested transactions then.
+  @ prototype
+      void backTestEventSkipping(boolean enabled)
+  @ params
+      enabled: true to skip the quiet transactions
+  @ return
+      void */
+void backTestEventSkipping(boolean enabled)
+{
+  isBackTestEventSkipping = enabled;
+}
+
+/* Trade price index
+
+  Segment trees keeping the maximum and the minimum trade price of every power-of-two range of the trade columns.
+  The leaves are at [priceTreeSize, 2 * priceTreeSize), node i covers the ranges of nodes 2i and 2i+1.
+  They answer "the first transaction in [i, j) above or below a price" and "the highest or lowest price in [i, j)" in O(log n). */
+
+integer priceTreeVersion = -1;     // tradeColumnsVersion the trees are built for
+integer priceTreeSize = 1;         // leaf count, a power of two
+float priceMaxTree[];
+float priceMinTree[];
+float tradeAmountPrefixSum[];      // tradeAmountPrefixSum[n] is the traded amount of the first n transactions
+
+/* Building the price index over the trade columns
+  @ prototype
+      void buildPriceTree()
+  @ return
+      void */
+void buildPriceTree()
+{
+  integer count = sizeof(tradePriceColumn);
+  float emptyMax[];
+  float emptyMin[];
+  float emptyAmounts[];
+  integer node;
+
+  priceMaxTree = emptyMax;
+  priceMinTree = emptyMin;
+  tradeAmountPrefixSum = emptyAmounts;
+  priceTreeSize = 1;
+  while (priceTreeSize < count)
+  {
+    priceTreeSize = priceTreeSize * 2;
+  }
+
+  for (integer i = 0; i < 2 * priceTreeSize; i++)
+  {
+    priceMaxTree >> -1.0;
+    priceMinTree >> unreachablePrice;
+  }
+  tradeAmountPrefixSum >> 0.0;
+  for (integer j = 0; j < count; j++)
+  {
+    priceMaxTree[priceTreeSize + j] = tradePriceColumn[j];
+    priceMinTree[priceTreeSize + j] = tradePriceColumn[j];
+    tradeAmountPrefixSum >> tradeAmountPrefixSum[j] + tradeAmountColumn[j];
+  }
+  for (node = priceTreeSize - 1; node >= 1; node--)
+  {
+    priceMaxTree[node] = priceMaxTree[2 * node];
+    if (priceMaxTree[2 * node + 1] > priceMaxTree[node])
+    {
+      priceMaxTree[node] = priceMaxTree[2 * node + 1];
+    }
+    priceMinTree[node] = priceMinTree[2 * node];
+    if (priceMinTree[2 * node + 1] < priceMinTree[node])
+    {
+      priceMinTree[node] = priceMinTree[2 * node + 1];
+    }
+  }
+  priceTreeVersion = tradeColumnsVersion;
+}
+
+/* Rebuilding the price index if the trade columns changed since it was built
+  @ prototype
+      void updatePriceTree()
+  @ return
+      void */
+void updatePriceTree()
+{
+  if (priceTreeVersion != tradeColumnsVersion)
+  {
+    buildPriceTree();
+  }
+}
+
+/* Searching the first transaction above a price
+  @ prototype
+      integer findFirstTradeAbove(integer from, integer to, float level)
+  @ params
+      from: index of the first searched transaction
+      to: index after the last searched transaction
+      level: the price to cross
+  @ return
+      index of the first transaction in [from, to) whose price is higher than the level, to if there is none */
+integer findFirstTradeAbove(integer from, integer to, float level)
+{
+  if (from >= to)
+    return to;
+
+  integer node = from + priceTreeSize;
+  while (priceMaxTree[node] <= level)
+  {
+    // move to the range right after the current node
+    while (node % 2 == 1)
+    {
+      node = node / 2;
+    }
+    if (node == 0)
+      return to;
+    node = node + 1;
+  }
+  while (node < priceTreeSize)
+  {
+    node = node * 2;
+    if (priceMaxTree[node] <= level)
+    {
+      node = node + 1;
+    }
+  }
+  if (node - priceTreeSize < to)
+    return (node - priceTreeSize);
+  return to;
+}
+
+/* Searching the first transaction below a price
+  @ prototype
+      integer findFirstTradeBelow(integer from, integer to, float level)
+  @ params
+      from: index of the first searched transaction
+      to: index after the last searched transaction
+      level: the price to cross
+  @ return
+      index of the first transaction in [from, to) whose price is lower than the level, to if there is none */
+integer findFirstTradeBelow(integer from, integer to, float level)
+{
+  if (from >= to)
+    return to;
+
+  integer node = from + priceTreeSize;
+  while (priceMinTree[node] >= level)
+  {
+    // move to the range right after the current node
+    while (node % 2 == 1)
+    {
+      node = node / 2;
+    }
+    if (node == 0)
+      return to;
+    node = node + 1;
+  }
+  while (node < priceTreeSize)
+  {
+    node = node * 2;
+    if (priceMinTree[node] >= level)
+    {
+      node = node + 1;
+    }
+  }
+  if (node - priceTreeSize < to)
+    return (node - priceTreeSize);
+  return to;
+}
+
+/* Highest trade price of a range
+  @ prototype
+      float rangeMaxPrice(integer from, integer to)
+  @ params
+      from: index of the first transaction
+      to: index after the last transaction
+  @ return
+      the highest price in [from, to), -1.0 for an empty range */
+float rangeMaxPrice(integer from, integer to)
+{
+  float result = -1.0;
+  integer left = from + priceTreeSize;
+  integer right = to + priceTreeSize;
+  while (left < right)
+  {
+    if (left % 2 == 1)
+    {
+      if (priceMaxTree[left] > result)
+      {
+        result = priceMaxTree[left];
+      }
+      left ++;
+    }
+    if (right % 2 == 1)
+    {
+      right --;
+      if (priceMaxTree[right] > result)
+      {
+        result = priceMaxTree[right];
+      }
+    }
+    left = left / 2;
+    right = right / 2;
+  }
+  return result;
+}
+
+/* Lowest trade price of a range
+  @ prototype
+      float rangeMinPrice(integer from, integer to)
+  @ params
+      from: index of the first transaction
+      to: index after the last transaction
+  @ return
+      the lowest price in [from, to), unreachablePrice for an empty range */
+float rangeMinPrice(integer from, integer to)
+{
+  float result = unreachablePrice;
+  integer left = from + priceTreeSize;
+  integer right = to + priceTreeSize;
+  while (left < right)
+  {
+    if (left % 2 == 1)
+    {
+      if (priceMinTree[left] < result)
+      {
+        result = priceMinTree[left];
+      }
+      left ++;
+    }
+    if (right % 2 == 1)
+    {
+      right --;
+      if (priceMinTree[right] < result)
+      {
+        result = priceMinTree[right];
+      }
+    }
+    left = left / 2;
+    right = right / 2;
+  }
+  return result;
+}
+
+/* Adding a range of transactions of the current bar to the bar builder at once
+  @ prototype
+      void barBuilderSkipTrades(integer from, integer to)
+  @ params
+      from: index of the first transaction
+      to: index after the last transaction, all of them must fall into the bar being built
+  @ return
+      void */
+void barBuilderSkipTrades(integer from, integer to)
+{
+  float high = rangeMaxPrice(from, to);
+  float low = rangeMinPrice(from, to);
+  if (high > barBuilderHigh)
+  {
+    barBuilderHigh = high;
+  }
+  if (low < barBuilderLow)
+  {
+    barBuilderLow = low;
+  }
+  barBuilderClose = tradePriceColumn[to - 1];
+  barBuilderVolume += tradeAmountPrefixSum[to] - tradeAmountPrefixSum[from];
+}
+
+/* Printing the elapsed time and the speed of a finished backtest replay
+  @ prototype
+      void printBackTestSpeed(integer transactionCount)
+  @ params
+      transactionCount: count of tested transactions
+  @ return
+      void */
+void printBackTestSpeed(integer transactionCount)
+{
+  integer elapsedTime = getCurrentTime() - backTestStartedAt;
+  print("Elapsed time : " + toString(elapsedTime / 1000) + " ms");
+  if (elapsedTime > 0)
+  {
+    print("Speed : " + toString(toFloat(transactionCount) * 1000000.0 / toFloat(elapsedTime)) + " trades/s");
+  }
+}
+
+/* Loading the transactions of a backtest into the trade columns
+  The lookback transactions for warming up and the tested ones are fetched at once, or streamed with backTestStreaming.
+  backTestStartIndex, backTestEndIndex and backTestCursor are set for the tested range.
+  @ prototype
+      integer loadBackTestTrades(string exchange, string symbol, integer lookbackStart, integer timeStart, integer timeEnd)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      lookbackStart: time stamp of the first lookback transaction
+      timeStart: time stamp of the first tested transaction
+      timeEnd: time stamp of the last tested transaction
+  @ return
+      index of the first lookback transaction */
+integer loadBackTestTrades(string exchange, string symbol, integer lookbackStart, integer timeStart, integer timeEnd)
+{
+  integer lookbackStartIndex = 0;
+  backTestDroppedCount = 0;
+  if (tradeStreamWindowLength > 0)
+  {
+    // only the lookback range and the first window are loaded, the rest is streamed while testing
+    tradeStreamOpen(exchange, symbol, timeStart, timeEnd);
+    clearTradeColumns();
+    appendTradesToColumns(getPubTrades(exchange, symbol, lookbackStart, timeStart - 1), lookbackStart, timeStart - 1);
+    backTestStartIndex = sizeof(tradeTimeColumn);
+    tradeStreamFetchNext();
+    backTestEndIndex = sizeof(tradeTimeColumn);
+  }
+  else
+  {
+    loadPubTrades(exchange, symbol, lookbackStart, timeEnd);
+    lookbackStartIndex = findTransactionIndexAtTime(lookbackStart);
+    backTestStartIndex = findTransactionIndexAtTime(timeStart);
+    backTestEndIndex = findTransactionIndexAtTime(timeEnd + 1);
+  }
+  backTestCursor = backTestStartIndex;
+  return lookbackStartIndex;
+}
+
+/* Closing the position left open at the last transaction of a backtest and printing the result
+  @ prototype
+      void finishBackTest(integer tradeTime, float tradePrice)
+  @ params
+      tradeTime: time of the last transaction
+      tradePrice: price of the last transaction
+  @ return
+      void */
+void finishBackTest(integer tradeTime, float tradePrice)
+{
+  float amount;
+
+  removeTimer(1);
+
+  positionState = nextPositionState(positionState, finalCloseEvent);
+  if (buyCount < sellCount)
+  {
+    // buy(exchangeSetting, symbolSetting, positionVolume, tradePrice, 0);
+    drawPoint(tradeTime, tradePrice, false, "buy");
+    setLineName("direction");
+    // draw the profit or loss line
+    if (tradePrice > lastOwnOrderPrice)
+    {          
+      setLineColor("green");
+    }
+    else
+    {
+      setLineColor("red");
+    }
+    drawLine(tradeTime, tradePrice);   
+    print("--- Market buy ordered : "+ toString(positionVolume) + "( price- " + toString(tradePrice) + ", time- " + timeToString(tradeTime, "yyyy-MM-dd hh:mm:ss") + " )");
+    amount = tradePrice * positionVolume;
+    buyTotal += amount;
+    buyCount ++;  
+    print(".       buy total is " + toString(buyTotal));
+  }
+  if (sellCount < buyCount)
+  {
+    // sell(exchangeSetting, symbolSetting, positionVolume, tradePrice, 0);
+    drawPoint(tradeTime, tradePrice, true, "sell");
+    setLineName("direction");
+    // draw the profit or loss line
+    if (tradePrice > lastOwnOrderPrice)
+    {          
+      setLineColor("green");
+    }
+    else
+    {
+      setLineColor("red");
+    }
+    drawLine(tradeTime, tradePrice);   
+
+    print("--- Market sell ordered : "+ toString(positionVolume) + "( price- " + toString(tradePrice) + ", time- " + timeToString(tradeTime, "yyyy-MM-dd hh:mm:ss") + " )");
+    amount = tradePrice * positionVolume;
+    sellTotal += amount;
+    sellCount ++;
+    print(".       sell total is " + toString(sellTotal));
+  }
+
+  print("--------------   Result   -------------------");
+  print("Total buy : " + toString(buyTotal) + " in " + toString(buyCount) );
+  print("Total sell : " + toString(sellTotal) + " in " + toString(sellCount) );
+  print("Total profit : " + toString(sellTotal-buyTotal));
+  printBackTestSpeed(backTestDroppedCount + backTestEndIndex - backTestStartIndex);
+
+  // the next strategy can start
+  isBackTestMode = false;
+  isBollingerBandsRunning = false;
+  isMACDRunning = false;
+  isRSIRunning = false;
+  isSARRunning = false;
+  isPipelineRunning = false;
+}
+
+/* Bar boundary scheduler
+
+  A timer added with a fixed interval drifts, every onTimedOut comes a little later than requested and the error piles up.
+  The scheduler keeps the absolute time of the next bar boundary instead, and arms a timer with the delay left until it
+  every time it fires, so the error of one tick is never carried to the next one.
+  The armed interval changes from tick to tick, onTimedOut asks barSchedulerTimedOut whether the timer is the scheduler's.
+  The lateness of every tick is kept as the jitter statistics. */
+
+integer barSchedulerLength = 0;          // bar length in micro seconds, 0 means the scheduler is stopped
+integer barSchedulerDeadline = 0;        // time stamp of the next bar boundary
+integer barSchedulerTimerInterval = 0;   // interval of the armed timer in milliseconds
+integer barSchedulerTickCount = 0;
+float barSchedulerJitterSum = 0.0;       // sum of the lateness in micro seconds
+float barSchedulerJitterSquaredSum = 0.0;
+integer barSchedulerMaxJitter = 0;
+
+/* Arming the timer for the next bar boundary after a time
+  @ prototype
+      void armBarScheduler(integer now)
+  @ params
+      now: the current time stamp
+  @ return
+      void */
+void armBarScheduler(integer now)
+{
+  barSchedulerDeadline = now - (now % barSchedulerLength) + barSchedulerLength;
+
+  // rounded up, the timer never fires before the boundary
+  integer interval = (barSchedulerDeadline - now + 999) / 1000;
+  // 1 ms is the backtest timer, the tick coalescing timer has its own interval
+  if (interval < 2)
+  {
+    interval = 2;
+  }
+  if (interval == tickCoalescingInterval)
+  {
+    interval ++;
+  }
+  if (interval != barSchedulerTimerInterval)
+  {
+    if (barSchedulerTimerInterval > 0)
+    {
+      removeTimer(barSchedulerTimerInterval);
+    }
+    addTimer(interval);
+    barSchedulerTimerInterval = interval;
+  }
+}
+
+/* Starting the scheduler at the bar boundaries
+  @ prototype
+      void startBarScheduler(integer barLength)
+  @ params
+      barLength: bar length in micro seconds
+  @ return
+      void */
+void startBarScheduler(integer barLength)
+{
+  barSchedulerLength = barLength;
+  barSchedulerTickCount = 0;
+  barSchedulerJitterSum = 0.0;
+  barSchedulerJitterSquaredSum = 0.0;
+  barSchedulerMaxJitter = 0;
+  armBarScheduler(getCurrentTime());
+}
+
+/* Stopping the scheduler
+  @ prototype
+      void stopBarScheduler()
+  @ return
+      void */
+void stopBarScheduler()
+{
+  if (barSchedulerTimerInterval > 0)
+  {
+    removeTimer(barSchedulerTimerInterval);
+  }
+  barSchedulerTimerInterval = 0;
+  barSchedulerLength = 0;
+}
+
+/* Handling a timer tick of the scheduler
+  @ prototype
+      boolean barSchedulerTimedOut(integer interval)
+  @ params
+      interval: interval of the fired timer
+  @ return
+      true: a bar boundary is passed, the timer is armed for the next one
+      false: the timer isn't the scheduler's, or it fired before the boundary and is armed again */
+boolean barSchedulerTimedOut(integer interval)
+{
+  if (barSchedulerLength == 0 || interval != barSchedulerTimerInterval)
+    return false;
+
+  integer now = getCurrentTime();
+  if (now < barSchedulerDeadline)
+  {
+    armBarScheduler(now);
+    return false;
+  }
+
+  integer jitter = now - barSchedulerDeadline;
+  barSchedulerTickCount ++;
+  barSchedulerJitterSum += toFloat(jitter);
+  barSchedulerJitterSquaredSum += toFloat(jitter) * toFloat(jitter);
+  if (jitter > barSchedulerMaxJitter)
+  {
+    barSchedulerMaxJitter = jitter;
+  }
+  armBarScheduler(now);
+  return true;
+}
+
+/* Printing the jitter statistics of the scheduler
+  @ prototype
+      void printBarSchedulerStats()
+  @ return
+      void */
+void printBarSchedulerStats()
+{
+  if (barSchedulerTickCount == 0)
+  {
+    print("No bar boundary is scheduled yet");
+    return;
+  }
+  float count = toFloat(barSchedulerTickCount);
+  float mean = barSchedulerJitterSum / count;
+  float variance = barSchedulerJitterSquaredSum / count - mean * mean;
+  if (variance < 0.0)
+  {
+    variance = 0.0;
+  }
+  print("Scheduled bar boundaries : " + toString(barSchedulerTickCount));
+  print("Jitter mean : " + toString(mean / 1000.0) + " ms, deviation : " + toString(sqrt(variance) / 1000.0) + " ms, max : " + toString(barSchedulerMaxJitter / 1000) + " ms");
+}
+
+/* Stop-Loss Ordering algo
+
+  =====================================================================================
+
+  About Stop-Loss Order (Buy or sell instructions according to predetermined limits):
+  -----------------------------------------------------------------------------------
+
+    A stop-loss order is a type of order used by traders to limit their loss or lock in a profit on an existing position.
+    Traders can control their exposure to risk by placing a stop-loss order.
+    Stop-loss orders are orders with instructions to close out a position by buying or selling a security at the market when it reaches a certain price known as the stop price.
+
+      - A stop-loss order instructs that a stock be bought or sold when it reaches a specified price known as the stop price.
+      - Once the stop price is met, the stop order becomes a market order and is executed at the next available opportunity.
+      - Stop-loss orders are used to limit loss or lock in profit on existing positions.
+      - They can protect investors with either long or short positions.
+      - A stop-loss order is different from a stop-limit order, the latter of which must execute at a specific price rather than at the market.
+    
+    Traders or investors may choose to use a stop-loss order to limit their losses and protect their profits.
+    By placing a stop-loss order, they can manage risk by exiting a position if the price for their security starts moving in the direction opposite to the position that they've taken.
+
+    Benefits of Stop-Loss Orders are as follows.
+      - Stop-loss orders are a smart and easy way to manage the risk of loss on a trade.
+      - They can help traders lock in profit.
+      - Every investor can make them a part of their investment strategy.
+      - They add discipline to an investor's short-term trading efforts.
+      - They take emotions out of trading.
+      - They eliminate the need to monitor investments on a daily (or hourly) basis.
+
+  Usage :
+  -----------------
+    Before buy or sell command, please execute like this,
+      stopLoss(0.1);  // 0.1 is a pip
+      trailingStopLoss(0.05);  // the stop follows the best price since the entry at 0.05 pip
+
+    The stop-loss and the trailing stop only protect the position first opened from flat, as the position state machine
+    runs the stop-out for it alone. Once a signal reverses it, the reversed position has no stop level and no best price
+    is tracked for it, and the stop runs again after the strategy is flat and enters a new position.
+
+  ===================================================================================== */
+
+// Stop-loss settings and flags
+float stopLossPip = 0.1;
+float trailingStopPip = 0.0;        // distance of the trailing stop from the best price, 0.0 disables the trailing
+float lockedPriceForProfit = 0.0;   // best price since the entry of the position, the trailing stop follows it
+float stopLossLevel = 0.0;          // stop price of the position, the tighter one of the fixed limit and the trailing level
+
+/* Computing the stop level of the position just entered at lastOwnOrderPrice
+  @ prototype
+      void resetStopLossLevel()
+  @ return
+      void */
+void resetStopLossLevel()
+{
+  integer action = positionActionOf(positionState, stopLossEvent);
+  float trailingLevel;
+
+  lockedPriceForProfit = lastOwnOrderPrice;
+  if (action == sellOrderAction)   // the long position
+  {
+    stopLossLevel = lastOwnOrderPrice * (1.0 - stopLossPip);
+    trailingLevel = lastOwnOrderPrice * (1.0 - trailingStopPip);
+    if (trailingStopPip > 0.0 && trailingLevel > stopLossLevel)
+    {
+      stopLossLevel = trailingLevel;
+    }
+  }
+  if (action == buyOrderAction)    // the short position
+  {
+    stopLossLevel = lastOwnOrderPrice * (1.0 + stopLossPip);
+    trailingLevel = lastOwnOrderPrice * (1.0 + trailingStopPip);
+    if (trailingStopPip > 0.0 && trailingLevel < stopLossLevel)
+    {
+      stopLossLevel = trailingLevel;
+    }
+  }
+}
+
+/* Resetting the position, the totals and the stop level before a strategy starts
+  The stop-loss settings are kept, a run never carries the position or the totals of the previous one.
+  @ prototype
+      void resetTradingState()
+  @ return
+      void */
+void resetTradingState()
+{
+  positionState = positionFlat;
+  buyTotal = 0.0;
+  buyCount = 0;
+  sellTotal = 0.0;
+  sellCount = 0;
+  lastOwnOrderPrice = 0.0;
+  lockedPriceForProfit = 0.0;
+  stopLossLevel = 0.0;
+  pendingSignalEvent = -1;
+}
+
+/* Execute the stop-loss algo
+  @ prototype
+      void stopLoss(float pip)
+  @ params
+      pip: pip setting value
+  @ return
+      void */
+void stopLoss(float pip)
+{
+  initPositionMachine();
+  stopLossPip = pip;
+  isStopLossRunning = true;
+  resetStopLossLevel();
+  isLiveTriggerOutdated = true;
+}
+
+/* Execute the stop-loss algo with a trailing stop
+  The stop level follows the best price since the entry at the given distance, it never moves back.
+  The fixed stop-loss of stopLoss keeps running, the tighter level of the two closes the position.
+  @ prototype
+      void trailingStopLoss(float pip)
+  @ params
+      pip: distance of the stop level from the best price, 0.0 disables the trailing
+  @ return
+      void */
+void trailingStopLoss(float pip)
+{
+  initPositionMachine();
+  trailingStopPip = pip;
+  isStopLossRunning = true;
+  resetStopLossLevel();
+  isLiveTriggerOutdated = true;
+}
+
+/* Lock in profit
+  Moving the trailing stop level with a new best price, one compare-and-update per price.
+  @ prototype
+      boolean trailingStop(float price)
+  @ params
+      price: the current price
+  @ return
+      true: the new profit locked in
+      false: didn't lock any profit */
+boolean trailingStop(float price)
+{
+  if (trailingStopPip <= 0.0)
+    return false;
+  float trailingLevel;
+  integer action = positionActionOf(positionState, stopLossEvent);
+  if (action == sellOrderAction)   // the long position
+  {
+    if (price <= lockedPriceForProfit)
+      return false;
+    lockedPriceForProfit = price;
+    trailingLevel = price * (1.0 - trailingStopPip);
+    if (trailingLevel > stopLossLevel)
+    {
+      stopLossLevel = trailingLevel;
+    }
+    return true;
+  }
+  if (action == buyOrderAction)    // the short position
+  {
+    if (price >= lockedPriceForProfit)
+      return false;
+    lockedPriceForProfit = price;
+    trailingLevel = price * (1.0 + trailingStopPip);
+    if (trailingLevel < stopLossLevel)
+    {
+      stopLossLevel = trailingLevel;
+    }
+    return true;
+  }
+  return false;
+}
+
+/* Determining and excuting the stop-loss order
+  @ prototype
+      boolean stopLossTick(integer timeStamp, float price)
+  @ params
+      timestamp: the time stamp for the price moment
+      price: the current price
+  @ return
+      true: the position is stopped, positionState moved along stopLossEvent
+      false: didn't stop the position */
+boolean stopLossTick(integer timeStamp, float price)
+{
+  integer action = positionActionOf(positionState, stopLossEvent);
+  if (action == noOrderAction)
+    return false;
+  float amount;
+  if (action == sellOrderAction)   // the long position is stopped
+  {
+    if (price < stopLossLevel)
+    {
+      if (isBackTestMode == false)
+      {
+        sellMarket(exchangeSetting, symbolSetting, positionVolume, 0);
+      }
+      drawPoint(timeStamp, price, true, "sell");
+      setLineName("direction");
+      setLineColor("green");
+      drawLine(timeStamp, price); 
+      amount = price * positionVolume;
+      sellTotal += amount;
+      sellCount ++;
+      // print(".       sell total is " + toString(sellTotal));
+      positionState = nextPositionState(positionState, stopLossEvent);
+      print("! Long position closed for stop loss : "+ toString(positionVolume) + "( price- " + toString(price) + ", time- " + timeToString(timeStamp, "yyyy-MM-dd hh:mm:ss") + " )");
+      return true;
+    }
+    trailingStop(price);
+    return false;
+  }
+  // the short position is stopped
+  if (price > stopLossLevel)
+  {
+    if (isBackTestMode == false)
+    {
+      buyMarket(exchangeSetting, symbolSetting, positionVolume, 0);
+    }
+    drawPoint(timeStamp, price, false, "buy");
+    setLineName("direction");
+    setLineColor("green");
+    drawLine(timeStamp, price); 
+    amount = price * positionVolume;
+    buyTotal += amount;
+    buyCount ++;  
+    // print(".       buy total is " + toString(buyTotal));
+    positionState = nextPositionState(positionState, stopLossEvent);
+    print("! Short position closed for stop loss: "+ toString(positionVolume) + "( price- " + toString(price) + ", time- " + timeToString(timeStamp, "yyyy-MM-dd hh:mm:ss") + " )");
+    return true;
+  }
+  trailingStop(price);
+  return false;
+}
+
+/* Searching the first transaction breaching a stop-loss limit in the trade columns
+  Same comparison as stopLossTick, answered by the price index in O(log n) instead of testing the transactions one by one.
+  Use findTransactionIndexAtTime to start from a time.
+  @ prototype
+      integer findStopLossTrade(integer fromIndex, float limitPrice, integer side)
+  @ params
+      fromIndex: index of the first searched transaction
+      limitPrice: the stop-loss limit price
+      side: positionLong to search a price below the limit, positionShort to search a price above it
+  @ return
+      index of the first breaching transaction, sizeof(tradePriceColumn) if there is none */
+integer findStopLossTrade(integer fromIndex, float limitPrice, integer side)
+{
+  integer count = sizeof(tradePriceColumn);
+  updatePriceTree();
+  if (side == positionLong)
+    return findFirstTradeBelow(fromIndex, count, limitPrice);
+  if (side == positionShort)
+    return findFirstTradeAbove(fromIndex, count, limitPrice);
+  return count;
+}
+
+/* Placing the order of a signal event and moving the position state along it
+  Used by the strategies whose signals come at the bar closes, the order is placed at the price after the signal.
+  @ prototype
+      boolean executeSignalOrder(integer event, integer timeStamp, float price)
+  @ params
+      event: sellSignalEvent or buySignalEvent
+      timeStamp: the time stamp for the price moment
+      price: the current price
+  @ return
+      true: the order is placed
+      false: the position state refused the event */
+boolean executeSignalOrder(integer event, integer timeStamp, float price)
+{
+  integer action = positionActionOf(positionState, event);
+  float amount = price * positionVolume;
+
+  if (action == sellOrderAction)
+  {
+    if (isBackTestMode == false)
+    {
+      sell(exchangeSetting, symbolSetting, positionVolume, price, 0);
+    }
+    drawPoint(timeStamp, price, true, "sell");
+    setLineName("direction");
+    // draw the profit or loss line
+    if (price > lastOwnOrderPrice)
+    {
+      setLineColor("green");
+    }
+    else
+    {
+      setLineColor("red");
+    }
+    drawLine(timeStamp, price);
+    print("--- Market sell ordered : "+ toString(positionVolume) + "( price- " + toString(price) + ", time- " + timeToString(timeStamp, "yyyy-MM-dd hh:mm:ss") + " )");
+    sellTotal += amount;
+    sellCount ++;
+  }
+  else
+  {
+    if (action != buyOrderAction)
+      return false;
+    if (isBackTestMode == false)
+    {
+      buy(exchangeSetting, symbolSetting, positionVolume, price, 0);
+    }
+    drawPoint(timeStamp, price, false, "buy");
+    setLineName("direction");
+    // draw the profit or loss line
+    if (price > lastOwnOrderPrice)
+    {
+      setLineColor("green");
+    }
+    else
+    {
+      setLineColor("red");
+    }
+    drawLine(timeStamp, price);
+    print("--- Market buy ordered : "+ toString(positionVolume) + "( price- " + toString(price) + ", time- " + timeToString(timeStamp, "yyyy-MM-dd hh:mm:ss") + " )");
+    buyTotal += amount;
+    buyCount ++;
+  }
+  lastOwnOrderPrice = price;
+  positionState = nextPositionState(positionState, event);
+  resetStopLossLevel();
+  isLiveTriggerOutdated = true;
+  return true;
+}
+
+/* Indicator pipeline
+
+  =====================================================================================
+
+  Runs several bar strategies on one feed. Every strategy registers against one bar stream per exchange, symbol and timeframe,
+  and reads its inputs from the features of the stream instead of keeping its own.
+
+    - A stream builds its bars once from the prices of its exchange and symbol, and keeps the true range of the last bar
+    - A window feature keeps the SMA and the standard deviation of the last N closes of a stream
+    - An EMA feature keeps the EMA of the closes of a stream
+    - A Wilder feature keeps the Wilder's averages of the gains and the losses of the closes of a stream
+
+  The features are added once per stream and period, the strategies asking for the same one share it, and every feature is
+  updated once per bar close in O(1). Bollinger bands read a window feature, MACD reads two EMA features and only keeps
+  its signal EMA, RSI reads a Wilder feature, Parabolic SAR reads the highs and the lows of its stream. Running them together costs one bar builder per stream and one update per feature,
+  about the cost of the most expensive one alone instead of their sum.
+
+  The strategies share one position, the orders are placed on the traded exchange and symbol given at the start.
+  The bar close signals of MACD and RSI are placed at the next price, the Bollinger bands and the SAR levels of the traded
+  symbol are checked with every price. The bar boundary scheduler runs at the shortest timeframe and closes the due bars of every stream.
+  The tick coalescing isn't applied to the pipeline.
+
+  Usage :
+  -----------------
+
+    pipelineAddBollinger("Centrabit", "LTC/BTC", "1m", 100, 2.0);
+    pipelineAddMACD("Centrabit", "LTC/BTC", "1m", 12, 26, 9);
+    pipelineAddRSI("Centrabit", "LTC/BTC", "1m", 14, 70.0, 30.0);
+    pipelineAddSAR("Centrabit", "LTC/BTC", "1h", 0.02, 0.2);
+
+    live:
+      pipeline("Centrabit", "LTC/BTC", 0.01);
+
+    backtest:
+      pipelineBackTest("Centrabit", "LTC/BTC", 0.01, "2022-11-01 00:00:00", "2022-11-26 00:00:00");
+      Only the streams of the tested exchange and symbol are replayed.
+
+    clearPipeline() removes all the strategies.
+
+  ===================================================================================== */
+
+// Feature kinds
+integer windowFeature = 0;
+integer emaFeature = 1;
+integer wilderFeature = 2;
+
+// Strategy kinds
+integer bollingerIndicator = 0;
+integer macdIndicator = 1;
+integer rsiIndicator = 2;
+integer sarIndicator = 3;
+
+integer windowReanchorInterval = 1000;     // the window sums are recomputed exactly every windowReanchorInterval bars so the drift stays bounded
+
+// Bar streams, one per exchange, symbol and timeframe
+string pipelineStreamExchange[];
+string pipelineStreamSymbol[];
+integer pipelineStreamLength[];            // bar length in micro seconds
+integer pipelineStreamOpenTime[];          // start time of the bar being built, -1 if no bar is open
+float pipelineStreamHigh[];
+float pipelineStreamLow[];
+float pipelineStreamClose[];
+integer pipelineStreamBarCount[];          // closed bar count
+float pipelineStreamPreviousClose[];
+float pipelineStreamTrueRange[];           // true range of the last closed bar
+integer pipelineWindowOffset[];            // the close windows of all streams are stored one after another in pipelineWindowCloses
+integer pipelineWindowCapacity[];          // longest window period of the stream plus one
+float pipelineWindowCloses[];              // pipelineWindowCloses[offset + n % capacity] is the close of the n-th bar
+
+// Features, one per stream, kind and period
+integer pipelineFeatureStream[];
+integer pipelineFeatureKind[];
+integer pipelineFeaturePeriod[];
+float pipelineFeatureMultiplier[];         // EMA smoothing multiplier
+float pipelineFeatureAnchor[];             // the window sums are accumulated around it, moved to the mean when they are recomputed
+float pipelineFeatureSum[];                // sum of (close - anchor) over the window
+float pipelineFeatureSquaredSum[];         // sum of (close - anchor)^2 over the window
+float pipelineFeatureValue[];              // SMA, EMA or average gain
+float pipelineFeatureSecondValue[];        // standard deviation or average loss
+
+// Strategies of the pipeline
+integer pipelineIndicatorKind[];
+integer pipelineIndicatorStream[];
+integer pipelineIndicatorFeature[];        // window feature, fast EMA feature or Wilder feature
+integer pipelineIndicatorSecondFeature[];  // slow EMA feature, -1 for the others
+integer pipelineIndicatorReadyBarCount[];  // closed bars needed before a signal
+integer pipelineIndicatorWarmUpBarCount[];
+float pipelineIndicatorDeviation[];
+float pipelineIndicatorUpperLevel[];       // upper band or overbought level
+float pipelineIndicatorLowerLevel[];       // lower band or oversold level
+float pipelineIndicatorMultiplier[];       // MACD signal EMA smoothing multiplier
+float pipelineIndicatorValue[];            // MACD histogram or RSI
+float pipelineIndicatorSignalEMA[];
+float pipelineIndicatorStep[];             // SAR acceleration factor step
+float pipelineIndicatorMaximum[];          // SAR maximum acceleration factor
+float pipelineIndicatorAcceleration[];
+float pipelineIndicatorExtremePoint[];
+integer pipelineIndicatorTrend[];          // 1 for a SAR uptrend, -1 for a downtrend
+float pipelineIndicatorPreviousHigh[];     // high of the bar before the last closed one
+float pipelineIndicatorPreviousLow[];
+
+/* Emptying the streams, the features and the strategies of the pipeline
+  @ prototype
+      void clearPipeline()
+  @ return
+      void */
+void clearPipeline()
+{
+  string emptyStrings[];
+  integer emptyIntegers[];
+  float emptyFloats[];
+
+  pipelineStreamExchange = emptyStrings;
+  pipelineStreamSymbol = emptyStrings;
+  pipelineStreamLength = emptyIntegers;
+  pipelineStreamOpenTime = emptyIntegers;
+  pipelineStreamHigh = emptyFloats;
+  pipelineStreamLow = emptyFloats;
+  pipelineStreamClose = emptyFloats;
+  pipelineStreamBarCount = emptyIntegers;
+  pipelineStreamPreviousClose = emptyFloats;
+  pipelineStreamTrueRange = emptyFloats;
+  pipelineWindowOffset = emptyIntegers;
+  pipelineWindowCapacity = emptyIntegers;
+  pipelineWindowCloses = emptyFloats;
+
+  pipelineFeatureStream = emptyIntegers;
+  pipelineFeatureKind = emptyIntegers;
+  pipelineFeaturePeriod = emptyIntegers;
+  pipelineFeatureMultiplier = emptyFloats;
+  pipelineFeatureAnchor = emptyFloats;
+  pipelineFeatureSum = emptyFloats;
+  pipelineFeatureSquaredSum = emptyFloats;
+  pipelineFeatureValue = emptyFloats;
+  pipelineFeatureSecondValue = emptyFloats;
+
+  pipelineIndicatorKind = emptyIntegers;
+  pipelineIndicatorStream = emptyIntegers;
+  pipelineIndicatorFeature = emptyIntegers;
+  pipelineIndicatorSecondFeature = emptyIntegers;
+  pipelineIndicatorReadyBarCount = emptyIntegers;
+  pipelineIndicatorWarmUpBarCount = emptyIntegers;
+  pipelineIndicatorDeviation = emptyFloats;
+  pipelineIndicatorUpperLevel = emptyFloats;
+  pipelineIndicatorLowerLevel = emptyFloats;
+  pipelineIndicatorMultiplier = emptyFloats;
+  pipelineIndicatorValue = emptyFloats;
+  pipelineIndicatorSignalEMA = emptyFloats;
+  pipelineIndicatorStep = emptyFloats;
+  pipelineIndicatorMaximum = emptyFloats;
+  pipelineIndicatorAcceleration = emptyFloats;
+  pipelineIndicatorExtremePoint = emptyFloats;
+  pipelineIndicatorTrend = emptyIntegers;
+  pipelineIndicatorPreviousHigh = emptyFloats;
+  pipelineIndicatorPreviousLow = emptyFloats;
+}
+
+/* Finding the bar stream of an exchange, a symbol and a timeframe, the stream is added if it doesn't exist yet
+  @ prototype
+      integer findPipelineStream(string exchange, string symbol, string typeStepSymbol)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+  @ return
+      index of the bar stream */
+integer findPipelineStream(string exchange, string symbol, string typeStepSymbol)
+{
+  integer barLength = barTimeLengthInMinutes(typeStepSymbol) * 60 * 1000 * 1000;
+  integer streamCount = sizeof(pipelineStreamLength);
+  for (integer s = 0; s < streamCount; s++)
+  {
+    if (pipelineStreamExchange[s] == exchange && pipelineStreamSymbol[s] == symbol && pipelineStreamLength[s] == barLength)
+      return s;
+  }
+
+  pipelineStreamExchange >> exchange;
+  pipelineStreamSymbol >> symbol;
+  pipelineStreamLength >> barLength;
+  pipelineStreamOpenTime >> -1;
+  pipelineStreamHigh >> 0.0;
+  pipelineStreamLow >> 0.0;
+  pipelineStreamClose >> 0.0;
+  pipelineStreamBarCount >> 0;
+  pipelineStreamPreviousClose >> 0.0;
+  pipelineStreamTrueRange >> 0.0;
+  pipelineWindowOffset >> 0;
+  pipelineWindowCapacity >> 0;
+  return streamCount;
+}
+
+/* Finding the feature of a stream, a kind and a period, the feature is added if it doesn't exist yet
+  @ prototype
+      integer findPipelineFeature(integer stream, integer kind, integer period)
+  @ params
+      stream: index of the bar stream
+      kind: windowFeature, emaFeature or wilderFeature
+      period: period of the feature in bars
+  @ return
+      index of the feature */
+integer findPipelineFeature(integer stream, integer kind, integer period)
+{
+  integer featureCount = sizeof(pipelineFeatureKind);
+  for (integer f = 0; f < featureCount; f++)
+  {
+    if (pipelineFeatureStream[f] == stream && pipelineFeatureKind[f] == kind && pipelineFeaturePeriod[f] == period)
+      return f;
+  }
+
+  pipelineFeatureStream >> stream;
+  pipelineFeatureKind >> kind;
+  pipelineFeaturePeriod >> period;
+  pipelineFeatureMultiplier >> calcEMAMultiplier(period);
+  pipelineFeatureAnchor >> 0.0;
+  pipelineFeatureSum >> 0.0;
+  pipelineFeatureSquaredSum >> 0.0;
+  pipelineFeatureValue >> 0.0;
+  pipelineFeatureSecondValue >> 0.0;
+  if (kind == windowFeature && period + 1 > pipelineWindowCapacity[stream])
+  {
+    pipelineWindowCapacity[stream] = period + 1;
+  }
+  return featureCount;
+}
+
+/* Adding a strategy to the pipeline
+  @ prototype
+      integer addPipelineIndicator(integer kind, integer stream, integer feature, integer secondFeature, integer readyBarCount, integer warmUpBarCount)
+  @ params
+      kind: bollingerIndicator, macdIndicator, rsiIndicator or sarIndicator
+      stream: index of the bar stream
+      feature: index of the first feature read by the strategy, -1 if there is none
+      secondFeature: index of the second feature read by the strategy, -1 if there is none
+      readyBarCount: closed bars needed before a signal
+      warmUpBarCount: lookback bars used for warming up
+  @ return
+      index of the strategy */
+integer addPipelineIndicator(integer kind, integer stream, integer feature, integer secondFeature, integer readyBarCount, integer warmUpBarCount)
+{
+  pipelineIndicatorKind >> kind;
+  pipelineIndicatorStream >> stream;
+  pipelineIndicatorFeature >> feature;
+  pipelineIndicatorSecondFeature >> secondFeature;
+  pipelineIndicatorReadyBarCount >> readyBarCount;
+  pipelineIndicatorWarmUpBarCount >> warmUpBarCount;
+  pipelineIndicatorDeviation >> 0.0;
+  pipelineIndicatorUpperLevel >> unreachablePrice;
+  pipelineIndicatorLowerLevel >> -1.0;
+  pipelineIndicatorMultiplier >> 0.0;
+  pipelineIndicatorValue >> 0.0;
+  pipelineIndicatorSignalEMA >> 0.0;
+  pipelineIndicatorStep >> 0.0;
+  pipelineIndicatorMaximum >> 0.0;
+  pipelineIndicatorAcceleration >> 0.0;
+  pipelineIndicatorExtremePoint >> 0.0;
+  pipelineIndicatorTrend >> 1;
+  pipelineIndicatorPreviousHigh >> 0.0;
+  pipelineIndicatorPreviousLow >> 0.0;
+  return sizeof(pipelineIndicatorKind) - 1;
+}
+
+/* Adding a Bollinger Bands strategy to the pipeline
+  @ prototype
+      integer pipelineAddBollinger(string exchange, string symbol, string typeStepSymbol, integer period, float deviation)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      period: period used to calculate SMA
+      deviation: deviation float number
+  @ return
+      index of the strategy */
+integer pipelineAddBollinger(string exchange, string symbol, string typeStepSymbol, integer period, float deviation)
+{
+  integer stream = findPipelineStream(exchange, symbol, typeStepSymbol);
+  integer feature = findPipelineFeature(stream, windowFeature, period);
+  integer i = addPipelineIndicator(bollingerIndicator, stream, feature, -1, period, period);
+  pipelineIndicatorDeviation[i] = deviation;
+  return i;
+}
+
+/* Count of the bars needed to warm up the EMAs
+  @ prototype
+      integer macdWarmUpBarCount(integer slowPeriod, integer signalPeriod)
+  @ params
+      slowPeriod: slow EMA period
+      signalPeriod: signal EMA period
+  @ return
+      bar count, the weight of the seed is below 1% after it */
+integer macdWarmUpBarCount(integer slowPeriod, integer signalPeriod)
+{
+  return 3 * (slowPeriod + signalPeriod);
+}
+
+/* Adding a MACD strategy to the pipeline
+  @ prototype
+      integer pipelineAddMACD(string exchange, string symbol, string typeStepSymbol, integer fastPeriod, integer slowPeriod, integer signalPeriod)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      fastPeriod: fast EMA period
+      slowPeriod: slow EMA period
+      signalPeriod: signal EMA period
+  @ return
+      index of the strategy */
+integer pipelineAddMACD(string exchange, string symbol, string typeStepSymbol, integer fastPeriod, integer slowPeriod, integer signalPeriod)
+{
+  integer stream = findPipelineStream(exchange, symbol, typeStepSymbol);
+  integer fastFeature = findPipelineFeature(stream, emaFeature, fastPeriod);
+  integer slowFeature = findPipelineFeature(stream, emaFeature, slowPeriod);
+  integer i = addPipelineIndicator(macdIndicator, stream, fastFeature, slowFeature, slowPeriod + signalPeriod, macdWarmUpBarCount(slowPeriod, signalPeriod));
+  pipelineIndicatorMultiplier[i] = calcEMAMultiplier(signalPeriod);
+  return i;
+}
+
+/* Count of the bars needed to warm up the averages
+  @ prototype
+      integer rsiWarmUpBarCount(integer period)
+  @ params
+      period: RSI period
+  @ return
+      bar count */
+integer rsiWarmUpBarCount(integer period)
+{
+  return 4 * period + 1;
+}
+
+/* Adding a RSI strategy to the pipeline
+  @ prototype
+      integer pipelineAddRSI(string exchange, string symbol, string typeStepSymbol, integer period, float overbought, float oversold)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      period: RSI period
+      overbought: overbought level
+      oversold: oversold level
+  @ return
+      index of the strategy */
+integer pipelineAddRSI(string exchange, string symbol, string typeStepSymbol, integer period, float overbought, float oversold)
+{
+  integer stream = findPipelineStream(exchange, symbol, typeStepSymbol);
+  integer feature = findPipelineFeature(stream, wilderFeature, period);
+  integer i = addPipelineIndicator(rsiIndicator, stream, feature, -1, period + 1, rsiWarmUpBarCount(period));
+  pipelineIndicatorUpperLevel[i] = overbought;
+  pipelineIndicatorLowerLevel[i] = oversold;
+  return i;
+}
+
+// Lookback bars used for warming up a SAR
+integer sarWarmUpBarCount = 50;
+
+/* Adding a Parabolic SAR strategy to the pipeline
+  @ prototype
+      integer pipelineAddSAR(string exchange, string symbol, string typeStepSymbol, float step, float maximum)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      step: acceleration factor step
+      maximum: maximum acceleration factor
+  @ return
+      index of the strategy */
+integer pipelineAddSAR(string exchange, string symbol, string typeStepSymbol, float step, float maximum)
+{
+  integer stream = findPipelineStream(exchange, symbol, typeStepSymbol);
+  integer i = addPipelineIndicator(sarIndicator, stream, -1, -1, 2, sarWarmUpBarCount);
+  pipelineIndicatorStep[i] = step;
+  pipelineIndicatorMaximum[i] = maximum;
+  return i;
+}
+
+/* Resetting the bars, the features and the strategies of the pipeline before a run
+  @ prototype
+      void resetPipeline()
+  @ return
+      void */
+void resetPipeline()
+{
+  float emptyFloats[];
+  integer offset = 0;
+
+  pipelineWindowCloses = emptyFloats;
+  for (integer s = 0; s < sizeof(pipelineStreamLength); s++)
+  {
+    pipelineStreamOpenTime[s] = -1;
+    pipelineStreamBarCount[s] = 0;
+    pipelineStreamTrueRange[s] = 0.0;
+    pipelineWindowOffset[s] = offset;
+    for (integer n = 0; n < pipelineWindowCapacity[s]; n++)
+    {
+      pipelineWindowCloses >> 0.0;
+    }
+    offset += pipelineWindowCapacity[s];
+  }
+  for (integer f = 0; f < sizeof(pipelineFeatureKind); f++)
+  {
+    pipelineFeatureSum[f] = 0.0;
+    pipelineFeatureSquaredSum[f] = 0.0;
+    pipelineFeatureValue[f] = 0.0;
+    pipelineFeatureSecondValue[f] = 0.0;
+  }
+  for (integer i = 0; i < sizeof(pipelineIndicatorKind); i++)
+  {
+    pipelineIndicatorValue[i] = 0.0;
+    pipelineIndicatorSignalEMA[i] = 0.0;
+    if (pipelineIndicatorKind[i] == bollingerIndicator || pipelineIndicatorKind[i] == sarIndicator)
+    {
+      pipelineIndicatorUpperLevel[i] = unreachablePrice;
+      pipelineIndicatorLowerLevel[i] = -1.0;
+    }
+    if (pipelineIndicatorKind[i] == sarIndicator)
+    {
+      pipelineIndicatorAcceleration[i] = pipelineIndicatorStep[i];
+      pipelineIndicatorTrend[i] = 1;
+    }
+    if (pipelineIndicatorKind[i] == rsiIndicator)
+    {
+      pipelineIndicatorValue[i] = 50.0;
+    }
+  }
+}
+
+/* Count of the lookback bars needed to warm up the strategies of a stream
+  @ prototype
+      integer pipelineWarmUpBarCount(integer stream)
+  @ params
+      stream: index of the bar stream
+  @ return
+      bar count */
+integer pipelineWarmUpBarCount(integer stream)
+{
+  integer count = 0;
+  for (integer i = 0; i < sizeof(pipelineIndicatorKind); i++)
+  {
+    if (pipelineIndicatorStream[i] == stream && pipelineIndicatorWarmUpBarCount[i] > count)
+    {
+      count = pipelineIndicatorWarmUpBarCount[i];
+    }
+  }
+  return count;
+}
+
+/* Lookback time needed to warm up the streams of an exchange and a symbol, their bars are built from the same transactions
+  @ prototype
+      integer pipelineLookbackLength(string exchange, string symbol)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+  @ return
+      lookback length in micro seconds */
+integer pipelineLookbackLength(string exchange, string symbol)
+{
+  integer length = 0;
+  for (integer s = 0; s < sizeof(pipelineStreamLength); s++)
+  {
+    if (pipelineStreamExchange[s] == exchange && pipelineStreamSymbol[s] == symbol && pipelineWarmUpBarCount(s) * pipelineStreamLength[s] > length)
+    {
+      length = pipelineWarmUpBarCount(s) * pipelineStreamLength[s];
+    }
+  }
+  return length;
+}
+
+/* Recomputing the sums of a window feature exactly around its mean
+  @ prototype
+      void reanchorPipelineWindow(integer f, integer length)
+  @ params
+      f: index of the window feature
+      length: count of the closes in the window
+  @ return
+      void */
+void reanchorPipelineWindow(integer f, integer length)
+{
+  integer s = pipelineFeatureStream[f];
+  integer offset = pipelineWindowOffset[s];
+  integer capacity = pipelineWindowCapacity[s];
+  integer count = pipelineStreamBarCount[s];
+  float anchor = pipelineFeatureValue[f];
+  float sum = 0.0;
+  float squaredSum = 0.0;
+  float diff;
+
+  for (integer n = count - length; n < count; n++)
+  {
+    diff = pipelineWindowCloses[offset + (n % capacity)] - anchor;
+    sum += diff;
+    squaredSum += diff * diff;
+  }
+  pipelineFeatureAnchor[f] = anchor;
+  pipelineFeatureSum[f] = sum;
+  pipelineFeatureSquaredSum[f] = squaredSum;
+}
+
+/* Updating a feature with the bar just closed in its stream, its close is already in the close window
+  @ prototype
+      void updatePipelineFeature(integer f, float closePrice, float previousClose)
+  @ params
+      f: index of the feature
+      closePrice: close price of the bar
+      previousClose: close price of the bar before it
+  @ return
+      void */
+void updatePipelineFeature(integer f, float closePrice, float previousClose)
+{
+  integer s = pipelineFeatureStream[f];
+  integer count = pipelineStreamBarCount[s];    // including the bar just closed
+  integer period = pipelineFeaturePeriod[f];
+  integer kind = pipelineFeatureKind[f];
+
+  if (kind == emaFeature)
+  {
+    // seeded with the first close
+    if (count == 1)
+    {
+      pipelineFeatureValue[f] = closePrice;
+      return;
+    }
+    pipelineFeatureValue[f] += pipelineFeatureMultiplier[f] * (closePrice - pipelineFeatureValue[f]);
+    return;
+  }
+
+  if (kind == wilderFeature)
+  {
+    // Wilder's averages of the gains and the losses, the first bar only gives the previous close
+    if (count == 1)
+      return;
+    float change = closePrice - previousClose;
+    float gain = 0.0;
+    float loss = 0.0;
+    float wilderPeriod = toFloat(period);
+    if (change > 0.0)
+    {
+      gain = change;
+    }
+    else
+    {
+      loss = -change;
+    }
+    if (count <= period + 1)
+    {
+      pipelineFeatureValue[f] += gain / wilderPeriod;
+      pipelineFeatureSecondValue[f] += loss / wilderPeriod;
+      return;
+    }
+    pipelineFeatureValue[f] = (pipelineFeatureValue[f] * (wilderPeriod - 1.0) + gain) / wilderPeriod;
+    pipelineFeatureSecondValue[f] = (pipelineFeatureSecondValue[f] * (wilderPeriod - 1.0) + loss) / wilderPeriod;
+    return;
+  }
+
+  // window feature, the window is shorter than the period until enough bars are closed
+  if (count == 1)
+  {
+    pipelineFeatureAnchor[f] = closePrice;
+  }
+  float anchor = pipelineFeatureAnchor[f];
+  float enteringDiff = closePrice - anchor;
+  pipelineFeatureSum[f] += enteringDiff;
+  pipelineFeatureSquaredSum[f] += enteringDiff * enteringDiff;
+  integer length = count;
+  if (count > period)
+  {
+    float leavingDiff = pipelineWindowCloses[pipelineWindowOffset[s] + ((count - 1 - period) % pipelineWindowCapacity[s])] - anchor;
+    pipelineFeatureSum[f] -= leavingDiff;
+    pipelineFeatureSquaredSum[f] -= leavingDiff * leavingDiff;
+    length = period;
+  }
+
+  float meanDiff = pipelineFeatureSum[f] / toFloat(length);
+  float variance = (pipelineFeatureSquaredSum[f] / toFloat(length)) - (meanDiff * meanDiff);
+  if (variance < 0.0)
+  {
+    variance = 0.0;
+  }
+  pipelineFeatureValue[f] = anchor + meanDiff;
+  pipelineFeatureSecondValue[f] = sqrt(variance);
+  if (count % windowReanchorInterval == 0)
+  {
+    reanchorPipelineWindow(f, length);
+  }
+}
+
+/* Updating a strategy with the features of the bar just closed in its stream
+  @ prototype
+      integer updatePipelineIndicator(integer i)
+  @ params
+      i: index of the strategy
+  @ return
+      sellSignalEvent or buySignalEvent if the strategy gives a bar close signal, -1 if not */
+integer updatePipelineIndicator(integer i)
+{
+  integer kind = pipelineIndicatorKind[i];
+  integer f = pipelineIndicatorFeature[i];
+  integer count = pipelineStreamBarCount[pipelineIndicatorStream[i]];
+  integer readyBarCount = pipelineIndicatorReadyBarCount[i];
+  float previousValue = pipelineIndicatorValue[i];
+
+  if (kind == bollingerIndicator)
+  {
+    // the bands are checked with every price, they are only armed when the window is full
+    if (count >= readyBarCount)
+    {
+      pipelineIndicatorUpperLevel[i] = calcBollingerUpperBand(pipelineFeatureValue[f], pipelineFeatureSecondValue[f], pipelineIndicatorDeviation[i]);
+      pipelineIndicatorLowerLevel[i] = calcBollingerLowerBand(pipelineFeatureValue[f], pipelineFeatureSecondValue[f], pipelineIndicatorDeviation[i]);
+    }
+    return -1;
+  }
+
+  if (kind == macdIndicator)
+  {
+    // the MACD line is the difference of the two EMA features, only the signal EMA is kept by the strategy
+    float macdLine = pipelineFeatureValue[f] - pipelineFeatureValue[pipelineIndicatorSecondFeature[i]];
+    pipelineIndicatorSignalEMA[i] += pipelineIndicatorMultiplier[i] * (macdLine - pipelineIndicatorSignalEMA[i]);
+    pipelineIndicatorValue[i] = macdLine - pipelineIndicatorSignalEMA[i];
+    if (count <= readyBarCount)
+      return -1;
+    if (previousValue <= 0.0 && pipelineIndicatorValue[i] > 0.0)
+      return buySignalEvent;
+    if (previousValue >= 0.0 && pipelineIndicatorValue[i] < 0.0)
+      return sellSignalEvent;
+    return -1;
+  }
+
+  // RSI, same value and signals as updateRSIValues
+  if (count < readyBarCount)
+    return -1;
+  if (pipelineFeatureSecondValue[f] == 0.0)
+  {
+    pipelineIndicatorValue[i] = 100.0;
+  }
+  else
+  {
+    pipelineIndicatorValue[i] = 100.0 - 100.0 / (1.0 + pipelineFeatureValue[f] / pipelineFeatureSecondValue[f]);
+  }
+  if (count == readyBarCount)
+    return -1;
+  if (previousValue <= pipelineIndicatorUpperLevel[i] && pipelineIndicatorValue[i] > pipelineIndicatorUpperLevel[i])
+    return sellSignalEvent;
+  if (previousValue >= pipelineIndicatorLowerLevel[i] && pipelineIndicatorValue[i] < pipelineIndicatorLowerLevel[i])
+    return buySignalEvent;
+  return -1;
+}
+
+/* Updating a Parabolic SAR strategy with the bar just closed in its stream
+  The SAR of the next bar is armed as its intra-bar level, the uptrend SAR as the sell level and the downtrend SAR as the
+  buy level.
+  @ prototype
+      void updatePipelineSAR(integer i, float high, float low, float closePrice, float previousClose)
+  @ params
+      i: index of the strategy
+      high: high price of the bar
+      low: low price of the bar
+      closePrice: close price of the bar
+      previousClose: close price of the previous bar
+  @ return
+      void */
+void updatePipelineSAR(integer i, float high, float low, float closePrice, float previousClose)
+{
+  integer count = pipelineStreamBarCount[pipelineIndicatorStream[i]];
+  float sar = pipelineIndicatorValue[i];
+  float extremePoint = pipelineIndicatorExtremePoint[i];
+  float acceleration = pipelineIndicatorAcceleration[i];
+  float previousHigh = pipelineIndicatorPreviousHigh[i];
+  float previousLow = pipelineIndicatorPreviousLow[i];
+  float nextValue;
+
+  if (count == 1)
+  {
+    pipelineIndicatorPreviousHigh[i] = high;
+    pipelineIndicatorPreviousLow[i] = low;
+    return;
+  }
+  if (count == 2)
+  {
+    // the first trend is the direction of the first two closes
+    if (closePrice >= previousClose)
+    {
+      pipelineIndicatorTrend[i] = 1;
+      nextValue = previousLow;
+      if (low < nextValue)
+      {
+        nextValue = low;
+      }
+      extremePoint = high;
+    }
+    else
+    {
+      pipelineIndicatorTrend[i] = -1;
+      nextValue = previousHigh;
+      if (high > nextValue)
+      {
+        nextValue = high;
+      }
+      extremePoint = low;
+    }
+    acceleration = pipelineIndicatorStep[i];
+  }
+  else
+  {
+    if (pipelineIndicatorTrend[i] == 1)
+    {
+      if (low < sar)
+      {
+        // stop and reverse, the SAR starts from the highest high of the uptrend
+        pipelineIndicatorTrend[i] = -1;
+        nextValue = extremePoint;
+        if (high > nextValue)
+        {
+          nextValue = high;
+        }
+        extremePoint = low;
+        acceleration = pipelineIndicatorStep[i];
+      }
+      else
+      {
+        if (high > extremePoint)
+        {
+          extremePoint = high;
+          acceleration += pipelineIndicatorStep[i];
+          if (acceleration > pipelineIndicatorMaximum[i])
+          {
+            acceleration = pipelineIndicatorMaximum[i];
+          }
+        }
+        nextValue = sar + acceleration * (extremePoint - sar);
+        if (nextValue > low)
+        {
+          nextValue = low;
+        }
+        if (nextValue > previousLow)
+        {
+          nextValue = previousLow;
+        }
+      }
+    }
+    else
+    {
+      if (high > sar)
+      {
+        // stop and reverse, the SAR starts from the lowest low of the downtrend
+        pipelineIndicatorTrend[i] = 1;
+        nextValue = extremePoint;
+        if (low < nextValue)
+        {
+          nextValue = low;
+        }
+        extremePoint = high;
+        acceleration = pipelineIndicatorStep[i];
+      }
+      else
+      {
+        if (low < extremePoint)
+        {
+          extremePoint = low;
+          acceleration += pipelineIndicatorStep[i];
+          if (acceleration > pipelineIndicatorMaximum[i])
+          {
+            acceleration = pipelineIndicatorMaximum[i];
+          }
+        }
+        nextValue = sar + acceleration * (extremePoint - sar);
+        if (nextValue < high)
+        {
+          nextValue = high;
+        }
+        if (nextValue < previousHigh)
+        {
+          nextValue = previousHigh;
+        }
+      }
+    }
+  }
+  pipelineIndicatorValue[i] = nextValue;
+  pipelineIndicatorExtremePoint[i] = extremePoint;
+  pipelineIndicatorAcceleration[i] = acceleration;
+  pipelineIndicatorPreviousHigh[i] = high;
+  pipelineIndicatorPreviousLow[i] = low;
+  if (pipelineIndicatorTrend[i] == 1)
+  {
+    pipelineIndicatorLowerLevel[i] = nextValue;
+    pipelineIndicatorUpperLevel[i] = unreachablePrice;
+  }
+  else
+  {
+    pipelineIndicatorLowerLevel[i] = -1.0;
+    pipelineIndicatorUpperLevel[i] = nextValue;
+  }
+}
+
+/* Closing a bar of a stream, every feature of the stream is updated once and read by its strategies
+  @ prototype
+      integer pipelinePushBar(integer s, float high, float low, float closePrice)
+  @ params
+      s: index of the bar stream
+      high: high price of the bar
+      low: low price of the bar
+      closePrice: close price of the bar
+  @ return
+      sellSignalEvent or buySignalEvent if a strategy of the stream gives a bar close signal, -1 if not */
+integer pipelinePushBar(integer s, float high, float low, float closePrice)
+{
+  integer count = pipelineStreamBarCount[s];
+  float previousClose = pipelineStreamPreviousClose[s];
+  integer event;
+  integer signalEvent = -1;
+
+  pipelineStreamTrueRange[s] = high - low;
+  if (count > 0)
+  {
+    if (previousClose > high)
+    {
+      pipelineStreamTrueRange[s] = previousClose - low;
+    }
+    if (previousClose < low)
+    {
+      pipelineStreamTrueRange[s] = high - previousClose;
+    }
+  }
+  if (pipelineWindowCapacity[s] > 0)
+  {
+    pipelineWindowCloses[pipelineWindowOffset[s] + (count % pipelineWindowCapacity[s])] = closePrice;
+  }
+  pipelineStreamBarCount[s] = count + 1;
+  pipelineStreamPreviousClose[s] = closePrice;
+
+  for (integer f = 0; f < sizeof(pipelineFeatureKind); f++)
+  {
+    if (pipelineFeatureStream[f] == s)
+    {
+      updatePipelineFeature(f, closePrice, previousClose);
+    }
+  }
+  for (integer i = 0; i < sizeof(pipelineIndicatorKind); i++)
+  {
+    if (pipelineIndicatorStream[i] == s && pipelineIndicatorKind[i] == sarIndicator)
+    {
+      // the SAR signals are its intra-bar levels
+      updatePipelineSAR(i, high, low, closePrice, previousClose);
+    }
+    if (pipelineIndicatorStream[i] == s && pipelineIndicatorKind[i] != sarIndicator)
+    {
+      event = updatePipelineIndicator(i);
+      if (event >= 0)
+      {
+        signalEvent = event;
+      }
+    }
+  }
+  return signalEvent;
+}
+
+/* Bollinger Bands trading strategy
+
+  =====================================================================================
+
+  About Bollinger Bands Indicator:
+  --------------------------------
+
+    Bollinger Bands are a popular technical indicator which use standard deviation to establish where a band of likely support and resistance levels might be found. 
+    A volatility channel plots lines above and below a central measure of price. 
+    These lines, also known as envelopes or bands, widen or contract according to how volatile or non-volatile a market is. 
+    Bollinger Bands measure market volatility and provide lots of useful information, including:
+
+      - Trend continuation or reversal
+      - Periods of market consolidation
+      - Periods of upcoming large volatility breakouts
+      - Possible market tops or bottoms and potential price targets
+    
+    Bollinger Bands consist of three lines, the middle of which is a Simple Moving Average (SMA) with the default value of 20. 
+    The upper and lower band are found two standard deviations either side of the SMA.
+
+    The most basic interpretation of Bollinger Bands is that the channels represent a measure of 'highness' and 'lowness'. 
+    Let's sum up three key points about Bollinger bands:
+
+      - The upper band shows a level that is statistically high or expensive
+      - The lower band shows a level that is statistically low or cheap
+      - The Bollinger Band width correlates to the volatility of the market
+          - In a more volatile market, Bollinger Bands widen
+          - In a less volatile market, the bands narrow
+
+    The Bollinger Bands contain a default setting in Forex trading as (20,2) - 
+    where 20 is the value for the SMA and 2 refers to the number of standard deviations the upper and lower band are either side of the SMA.
 
     The default Bollinger Bands® formula consists of:
 
-    - An N-period moving average (MA)
-    - An upper band at K times and an N-period standard deviation above the moving average (MA + Kσ)
-    - A lower band at K times and an N-period standard deviation below the moving average (MA − Kσ)
+    - An N-period moving average (MA)
+    - An upper band at K times and an N-period standard deviation above the moving average (MA + Kσ)
+    - A lower band at K times and an N-period standard deviation below the moving average (MA − Kσ)
+
+  Usage :
+  -----------------
+
+
+    backtest:
+      backtestBollingerBands("Centrabit", "LTC/BTC", 20, 2.0, "1d", 1000, 0.01);
+      It tests Bollinger Bands trading strategy with last 1000 days data.
+      20 means SMA period, 2.0 is deviation, "1d" represents the duration of a bar.
+      Last parameter 0.01 is the amount to sell or buy at once.
+
+      backTestTurbo(10000);
+      Tests 10000 transactions per timer tick instead of one, the totals are the same.
+
+    The bands are kept by the indicator pipeline, they are armed once the bars of a whole SMA period are closed.
+    Starting the strategy replaces the strategies added to the pipeline.
+
+  ===================================================================================== */
+
+// Global values for bollinger bands 
+integer bollingerSettingPeriod = 20;
+float bollingerSettingDeviation = 2.0;
+integer bollingerBarTimeLengthInMinutes = 0;
+
+float bollingerSMA = 100.0;
+float bollingerSTDDEV = 0.0;
+float bollingerUpperBand = 0.0;
+float bollingerLowerBand = 0.0;
+integer bollingerPipelineIndicator = -1;   // the bollinger strategy registered in the pipeline, its window feature keeps the SMA and the standard deviation
+
+// Precomputed band series of a backtest, they only depend on the bar closes, not on the positions or on the stop-loss
+// Element 0 keeps the bands after warming up, element k keeps the bands after the k-th bar closed in the tested range
+string bandSeriesKey = "";             // exchange, symbol, tested range, period, deviation and bar length of the series
+boolean isBandSeriesComplete = false;  // the series covers the whole tested range
+boolean isBandSeriesUsed = false;      // the running backtest reads the series instead of computing the bands
+integer bandSeriesCursor = 0;
+integer bandSeriesCloseTime[];         // time of the transaction which closed the bar
+float bandSeriesMiddle[];
+float bandSeriesUpper[];
+float bandSeriesLower[];
+
+
+/* Registering the bollinger bands as the only strategy of the pipeline
+  @ prototype
+      void resetBollingerBands(string exchange, string symbol, string typeStepSymbol, integer period, float deviation)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      period: period used to calculate SMA
+      deviation: deviation float number
+  @ return
+      void */
+void resetBollingerBands(string exchange, string symbol, string typeStepSymbol, integer period, float deviation)
+{
+  clearPipeline();
+  bollingerPipelineIndicator = pipelineAddBollinger(exchange, symbol, typeStepSymbol, period, deviation);
+  resetPipeline();
+}
+
+/* Reading the band values from the pipeline
+  The SMA is the one of the closes pushed so far, the bands are those of the pipeline strategy, armed once the window is full.
+  @ prototype
+      void readBollingerBandValues()
+  @ return
+      void */
+void readBollingerBandValues()
+{
+  integer i = bollingerPipelineIndicator;
+  integer f = pipelineIndicatorFeature[i];
+  bollingerSMA = pipelineFeatureValue[f];
+  bollingerSTDDEV = pipelineFeatureSecondValue[f];
+  bollingerUpperBand = pipelineIndicatorUpperLevel[i];
+  bollingerLowerBand = pipelineIndicatorLowerLevel[i];
+}
+
+/* Pushing the bar just closed by the bar builder into the pipeline and reading the band values in O(1)
+  @ prototype
+      void updateBollingerBandValues()
+  @ return
+      void */
+void updateBollingerBandValues()
+{
+  pipelinePushBar(pipelineIndicatorStream[bollingerPipelineIndicator], closedBarHigh, closedBarLow, closedBarClose);
+  readBollingerBandValues();
+}
+
+/* Warming up the bollinger bands from the lookback transactions in the trade columns
+  The lookback transactions are aggregated into time bars, the last bar keeps being built with the tested transactions.
+  The bands are registered in the pipeline by resetBollingerBands before.
+  @ prototype
+      boolean warmUpBollingerBands(integer fromIndex, integer toIndex)
+  @ params
+      fromIndex: index of the first lookback transaction
+      toIndex: index after the last lookback transaction
+  @ return
+      true: the initial bands are computed
+      false: no lookback bar is found */
+boolean warmUpBollingerBands(integer fromIndex, integer toIndex)
+{
+  barBuilderReset(bollingerBarTimeLengthInMinutes * 60 * 1000 * 1000);
+  for (integer i=fromIndex; i<toIndex; i++)
+  {
+    if (barBuilderAddTrade(tradeTimeColumn[i], tradePriceColumn[i], tradeAmountColumn[i]) == true)
+    {
+      updateBollingerBandValues();
+    }
+  }
+  if (pipelineStreamBarCount[pipelineIndicatorStream[bollingerPipelineIndicator]] == 0)
+    return false;
+  return true;
+}
+
+/* Band series key
+  @ prototype
+      string bandSeriesKeyOf(string exchange, string symbol, integer period, float deviation, integer barLengthInMinutes, integer timeStart, integer timeEnd)
+  @ return
+      string identifying the bands of a tested range */
+string bandSeriesKeyOf(string exchange, string symbol, integer period, float deviation, integer barLengthInMinutes, integer timeStart, integer timeEnd)
+{
+  return (exchange + "|" + symbol + "|" + toString(period) + "|" + toString(deviation) + "|" + toString(barLengthInMinutes) + "|" + toString(timeStart) + "|" + toString(timeEnd));
+}
+
+/* Starting a new band series
+  @ prototype
+      void clearBandSeries(string key)
+  @ params
+      key: key of the series returned by bandSeriesKeyOf
+  @ return
+      void */
+void clearBandSeries(string key)
+{
+  integer emptyTimes[];
+  float emptyMiddle[];
+  float emptyUpper[];
+  float emptyLower[];
+
+  bandSeriesKey = key;
+  isBandSeriesComplete = false;
+  bandSeriesCloseTime = emptyTimes;
+  bandSeriesMiddle = emptyMiddle;
+  bandSeriesUpper = emptyUpper;
+  bandSeriesLower = emptyLower;
+}
+
+/* Appending the current bands to the band series
+  @ prototype
+      void recordBandSeries(integer closeTime)
+  @ params
+      closeTime: time of the transaction which closed the bar, 0 for the bands after warming up
+  @ return
+      void */
+void recordBandSeries(integer closeTime)
+{
+  bandSeriesCloseTime >> closeTime;
+  bandSeriesMiddle >> bollingerSMA;
+  bandSeriesUpper >> bollingerUpperBand;
+  bandSeriesLower >> bollingerLowerBand;
+}
+
+/* Moving to the next bands of the series when the transaction closes a bar
+  @ prototype
+      boolean nextBandSeriesValues(integer tradeTime)
+  @ params
+      tradeTime: time of the tested transaction
+  @ return
+      true: the bands are updated
+      false: the transaction didn't close a bar */
+boolean nextBandSeriesValues(integer tradeTime)
+{
+  if (bandSeriesCursor + 1 >= sizeof(bandSeriesCloseTime))
+    return false;
+  if (tradeTime < bandSeriesCloseTime[bandSeriesCursor + 1])
+    return false;
+
+  bandSeriesCursor ++;
+  bollingerSMA = bandSeriesMiddle[bandSeriesCursor];
+  bollingerUpperBand = bandSeriesUpper[bandSeriesCursor];
+  bollingerLowerBand = bandSeriesLower[bandSeriesCursor];
+  return true;
+}
+
+/* Live trigger thresholds
+
+  The live tick only compares the price with these thresholds, they are computed again when a bar closes or the position changes.
+  A price between liveLowerTrigger and liveUpperTrigger can't place an order. */
+
+float liveSellTrigger = unreachablePrice;    // the upper band while a sell signal is possible
+float liveBuyTrigger = -1.0;                 // the lower band while a buy signal is possible
+float liveStopLossLimit = -1.0;              // the stop-loss limit price of the open position
+float liveUpperTrigger = unreachablePrice;   // a higher price must be handled
+float liveLowerTrigger = -1.0;               // a lower price must be handled
+
+/* Computing the live trigger thresholds from the bands and the position
+  @ prototype
+      void updateLiveTriggers()
+  @ return
+      void */
+void updateLiveTriggers()
+{
+  liveSellTrigger = unreachablePrice;
+  liveBuyTrigger = -1.0;
+  liveStopLossLimit = -1.0;
+  liveUpperTrigger = unreachablePrice;
+  liveLowerTrigger = -1.0;
+  isLiveTriggerOutdated = false;
+
+  // the backtests don't trade on the live prices
+  if (isBackTestMode == true)
+    return;
+
+  if (isBollingerBandsRunning == true)
+  {
+    if (positionActionOf(positionState, sellSignalEvent) == sellOrderAction)
+    {
+      liveSellTrigger = bollingerUpperBand;
+    }
+    if (positionActionOf(positionState, buySignalEvent) == buyOrderAction)
+    {
+      liveBuyTrigger = bollingerLowerBand;
+    }
+  }
+  liveUpperTrigger = liveSellTrigger;
+  liveLowerTrigger = liveBuyTrigger;
+  // the next price places the order of the signal
+  if (pendingSignalEvent >= 0)
+  {
+    liveUpperTrigger = -1.0;
+  }
+  if (isSARRunning == true)
+  {
+    if (intraBarSellLevel > liveLowerTrigger)
+    {
+      liveLowerTrigger = intraBarSellLevel;
+    }
+    if (intraBarBuyLevel < liveUpperTrigger)
+    {
+      liveUpperTrigger = intraBarBuyLevel;
+    }
+  }
+
+  if (isStopLossRunning == true)
+  {
+    integer stopAction = positionActionOf(positionState, stopLossEvent);
+    // a new best price moves the trailing stop, one threshold per side still covers both
+    if (stopAction == sellOrderAction)   // the long position
+    {
+      liveStopLossLimit = stopLossLevel;
+      if (liveStopLossLimit > liveLowerTrigger)
+      {
+        liveLowerTrigger = liveStopLossLimit;
+      }
+      if (trailingStopPip > 0.0 && lockedPriceForProfit < liveUpperTrigger)
+      {
+        liveUpperTrigger = lockedPriceForProfit;
+      }
+    }
+    if (stopAction == buyOrderAction)    // the short position
+    {
+      liveStopLossLimit = stopLossLevel;
+      if (liveStopLossLimit < liveUpperTrigger)
+      {
+        liveUpperTrigger = liveStopLossLimit;
+      }
+      if (trailingStopPip > 0.0 && lockedPriceForProfit > liveLowerTrigger)
+      {
+        liveLowerTrigger = lockedPriceForProfit;
+      }
+    }
+  }
+}
+
+/* Bollinger Bands strategy process
+  @ prototype
+      string bollingerBands(string exchange, string symbol, float price, integer period, float deviation, string typeStepSymbol)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      price: new price
+      period: period used to calculate SMA
+      deviation: deviation float number
+      typeStepSymbol: symbol string to represent time step - format : "number" + "expression letter" (ex: "1m", "3m", "5m", "15m", "1d", "3d", ... "1M", "2M"...)
+  @ return
+      signal string ("buy" or "sell") */
+void bollingerBands(string exchange, string symbol, integer period, float deviation, string typeStepSymbol, float volume)
+{  
+  if (canStartStrategy("Bollinger Bands") == false)
+    return;
+  initPositionMachine();
+  resetTradingState();
+  bollingerBarTimeLengthInMinutes = barTimeLengthInMinutes(typeStepSymbol);
+
+  integer now = getCurrentTime();
+  integer lookbackStart = now - (period * bollingerBarTimeLengthInMinutes * 60 * 1000 * 1000);
+  loadPubTrades(exchange, symbol, lookbackStart, now);
+  resetBollingerBands(exchange, symbol, typeStepSymbol, period, deviation);
+  if (warmUpBollingerBands(findTransactionIndexAtTime(lookbackStart), sizeof(tradeTimeColumn)) == false)
+  {
+    print("No lookback bar is found before " + timeToString(now, "yyyy-MM-dd hh:mm:ss"));
+    return;
+  }
+  setChartsExchange(exchange);
+  setChartsSymbol(symbol);
+  clearCharts();
+  setChartsTime(getCurrentTime() +  30 * 24 * 60*1000000);
+
+  // print("SMA period is " + toString(pipelineStreamBarCount[pipelineIndicatorStream[bollingerPipelineIndicator]]));
+
+  print("Initial SMA :" + toString(bollingerSMA));
+  print("Initial bollingerSTDDEV :" + toString(bollingerSTDDEV));
+  print("Initial bollingerUpperBand :" + toString(bollingerUpperBand));
+  print("Initial bollingerLowerBand :" + toString(bollingerLowerBand));
+
+  exchangeSetting = exchange;
+  symbolSetting = symbol;
+
+  bollingerSettingPeriod = period;
+  bollingerSettingDeviation = deviation;
+  positionVolume = volume;
+  lastPrice = tradePriceColumn[sizeof(tradePriceColumn)-1];
+
+  isBollingerBandsRunning = true;
+  isBackTestMode = false;
+  updateLiveTriggers();
+
+  print("--------------   Running   -------------------");
+
+  // the bars are built from the live prices, aligned to the bar boundaries
+  barBuilderReset(bollingerBarTimeLengthInMinutes * 60 * 1000 * 1000);
+  startBarScheduler(bollingerBarTimeLengthInMinutes * 60 * 1000 * 1000);
+}
+
+void updateBollingerBands(float closePrice)
+{
+    // print("time differ is : " + toString(timeDiffer));
+    // print("bar time length : " + toString(barTimeLength));
+    print("----------------------------------------");
+    print("SMA input added : " + toString(closePrice) + "  Time:" + timeToString(getCurrentTime(), "yyyy-MM-dd hh:mm:ss"));
+    print("Old SMA: " + toString(bollingerSMA));
+    updateBollingerBandValues();
+    updateLiveTriggers();
+
+    // the band lines are drawn once per bar, the ticks between the thresholds aren't handled
+    setLineName("middle");
+    setLineColor("grey");
+    drawLine(getCurrentTime(), bollingerSMA);
+
+    // the bands aren't armed until the window is full
+    if (bollingerUpperBand < unreachablePrice)
+    {
+      setLineName("uppper");
+      setLineColor("#293119");
+      drawLine(getCurrentTime(), bollingerUpperBand);
+
+      setLineName("lower");
+      setLineColor("black");
+      drawLine(getCurrentTime(), bollingerLowerBand);
+    }
+
+    print("New SMA :" + toString(bollingerSMA));
+    // print("bollingerSTDDEV :" + toString(bollingerSTDDEV));
+    // print("bollingerUpperBand :" + toString(bollingerUpperBand));
+    // print("bollingerLowerBand :" + toString(bollingerLowerBand));
+}
+
+void bollingerBandsTick(float price)
+{
+  lastPrice = price;
+
+  float amount;
+  if (price > bollingerUpperBand)
+  {
+    if (positionActionOf(positionState, sellSignalEvent) == sellOrderAction)
+    {
+      sell(exchangeSetting, symbolSetting, positionVolume, price, 0);
+      drawPoint(getCurrentTime(), price, true, "sell");
+      print("--- Market sell ordered : "+ toString(positionVolume) + "( price- " + toString(price) + ", time- " + timeToString(getCurrentTime(), "yyyy-MM-dd hh:mm:ss") + " )");
+      lastOwnOrderPrice = price;
+      positionState = nextPositionState(positionState, sellSignalEvent);
+      resetStopLossLevel();
+      amount = price * positionVolume;
+      sellTotal += amount;
+      sellCount ++;
+      return;
+    }
+  }
+  if (price < bollingerLowerBand)
+  {
+    if (positionActionOf(positionState, buySignalEvent) == buyOrderAction)
+    {
+      buy(exchangeSetting, symbolSetting, positionVolume, price, 0);
+      drawPoint(getCurrentTime(), price, false, "buy");
+      print("--- Market buy ordered : "+ toString(positionVolume) + "( price- " + toString(price) + ", time- " + timeToString(getCurrentTime(), "yyyy-MM-dd hh:mm:ss") + " )");
+      lastOwnOrderPrice = price;
+      positionState = nextPositionState(positionState, buySignalEvent);
+      resetStopLossLevel();
+      amount = price * positionVolume;
+      buyTotal += amount;
+      buyCount ++;  
+      return;
+    }
+  }
+  // print("SMA :" + toString(bollingerSMA));
+  // print("bollingerUpperBand :" + toString(bollingerUpperBand));
+  // print("bollingerLowerBand :" + toString(bollingerLowerBand));
+
+  // setLineName("price");
+  // setLineColor("pink");
+  // drawLine(getCurrentTime(), price);
+}
+
+/* Bollinger Bands strategy backtest
+  @ prototype
+      string backtestBollingerBands(string exchange, string symbol, float price, integer period, float deviation, string typeStepSymbol, integer lookbackPeriod, float bidAmount)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      period: period used to calculate SMA
+      deviation: deviation float number
+      typeStepSymbol: symbol string to represent time step - format : "number" + "expression letter" (ex: "1m", "3m", "5m", "15min", "1d", "3d", ... "1M", "2M"...)
+      lookbackPeriod: lookback bar count
+      volume: amount of trading(buy or sell) at once
+  @ return
+      none */
+void bollingerBandsBackTest(string exchange, string symbol, integer period, float deviation, string typeStepSymbol, float volume, string startDateTime, string endDateTime)
+{  
+  if (canStartStrategy("Bollinger Bands backtest") == false)
+    return;
+  initPositionMachine();
+  resetTradingState();
+  bollingerBarTimeLengthInMinutes = barTimeLengthInMinutes(typeStepSymbol);
+
+  // strinsert(strDateTime, strlength(strDateTime)-1, " 00:00:00");
+  // strinsert(strEndTime, strlength(strEndTime)-1, " 23:59:59");
+
+  integer timeStart = stringToTime(startDateTime, "yyyy-MM-dd hh:mm:ss");
+  integer timeEnd = stringToTime(endDateTime, "yyyy-MM-dd hh:mm:ss");
+  // print("Translated start date : " + toString(timeStart));
+  // print("Translated end date : " + toString(timeEnd));
+  // print("Retranslated start date : " + timeToString(timeStart, "yyyy-MM-dd hh:mm:ss"));
+  // print("Retranslated end date : " + timeToString(timeEnd, "yyyy-MM-dd hh:mm:ss"));
+
+  // the lookback transactions for warming up and the tested ones are fetched at once
+  integer lookbackStart = timeStart - (period * bollingerBarTimeLengthInMinutes * 60 * 1000 * 1000);
+  print("Fetching transactions from " + timeToString(lookbackStart, "yyyy-MM-dd hh:mm:ss") + " to " + endDateTime + "...");
+  integer lookbackStartIndex = loadBackTestTrades(exchange, symbol, lookbackStart, timeStart, timeEnd);
+  // print("   Result : " + toString(backTestEndIndex - lookbackStartIndex) + " of transactions are fetched.");
+  // print("Started at : " + timeToString(tradeTimeColumn[backTestStartIndex], "yyyy-MM-dd hh:mm:ss"));
+  // print("Ended at : " + timeToString(tradeTimeColumn[backTestEndIndex-1], "yyyy-MM-dd hh:mm:ss"));
+  if (backTestStartIndex >= backTestEndIndex)
+  {
+    print("No transaction is found from " + startDateTime + " to " + endDateTime);
+    return;
+  }
+
+  setChartsExchange(exchange);
+  setChartsSymbol(symbol);
+  clearCharts();
+
+  // the bands don't depend on the stop-loss or on the volume, the series of a previous backtest over the same range can be reused
+  string seriesKey = bandSeriesKeyOf(exchange, symbol, period, deviation, bollingerBarTimeLengthInMinutes, timeStart, timeEnd);
+  isBandSeriesUsed = (isBandSeriesComplete == true && seriesKey == bandSeriesKey);
+  if (isBandSeriesUsed == true)
+  {
+    print("Using precomputed bands...");
+    bandSeriesCursor = 0;
+    bollingerSMA = bandSeriesMiddle[0];
+    bollingerUpperBand = bandSeriesUpper[0];
+    bollingerLowerBand = bandSeriesLower[0];
+    // the series doesn't keep the standard deviation, it's the distance of the armed bands
+    bollingerSTDDEV = 0.0;
+    if (deviation > 0.0 && bollingerUpperBand < unreachablePrice)
+    {
+      bollingerSTDDEV = (bollingerUpperBand - bollingerSMA) / deviation;
+    }
+  }
+  else
+  {
+    // init lookback bar generating
+    print("Preparing lookback bars...");
+    resetBollingerBands(exchange, symbol, typeStepSymbol, period, deviation);
+    if (warmUpBollingerBands(lookbackStartIndex, backTestStartIndex) == false)
+    {
+      print("No lookback bar is found before " + startDateTime);
+      return;
+    }
+    print("SMA period is " + toString(pipelineStreamBarCount[pipelineIndicatorStream[bollingerPipelineIndicator]]));
+    clearBandSeries(seriesKey);
+    recordBandSeries(0);
+  }
+
+  print("Initial SMA :" + toString(bollingerSMA));
+  print("Initial bollingerSTDDEV :" + toString(bollingerSTDDEV));
+  print("Initial bollingerUpperBand :" + toString(bollingerUpperBand));
+  print("Initial bollingerLowerBand :" + toString(bollingerLowerBand));
+
+  exchangeSetting = exchange;
+  symbolSetting = symbol;
+  print("Initial price is " + toString(tradePriceColumn[backTestStartIndex]));
+
+  bollingerSettingPeriod = period;
+  bollingerSettingDeviation = deviation;
+  positionVolume = volume;
+  lastPrice = tradePriceColumn[backTestStartIndex];
+
+  isBollingerBandsRunning = true;
+  isBackTestMode = true;
+  isLiveTriggerOutdated = true;
+
+  print("--------------   Running   -------------------");
+  
+  setChartsTime(tradeTimeColumn[backTestStartIndex] +  30 * 24 * 60*1000000);
+
+  backTestStartedAt = getCurrentTime();
+  addTimer(1);
+}
+
+/* Precomputing the bollinger bands of a tested range
+  The next bollingerBandsBackTest and bollingerBandsStopLossSweep calls with the same exchange, symbol, period, deviation,
+  bar length and range only run the signals over the precomputed bands, whatever the stop-loss or the volume is.
+  @ prototype
+      void precomputeBollingerBands(string exchange, string symbol, integer period, float deviation, string typeStepSymbol, string startDateTime, string endDateTime)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      period: period used to calculate SMA
+      deviation: deviation float number
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      startDateTime: start of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+      endDateTime: end of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+  @ return
+      none */
+void precomputeBollingerBands(string exchange, string symbol, integer period, float deviation, string typeStepSymbol, string startDateTime, string endDateTime)
+{
+  // the trade columns and the pipeline of a running strategy would be replaced
+  if (canStartStrategy("Bollinger Bands precomputing") == false)
+    return;
+  bollingerBarTimeLengthInMinutes = barTimeLengthInMinutes(typeStepSymbol);
+  bollingerSettingDeviation = deviation;
+  integer timeStart = stringToTime(startDateTime, "yyyy-MM-dd hh:mm:ss");
+  integer timeEnd = stringToTime(endDateTime, "yyyy-MM-dd hh:mm:ss");
+  integer lookbackStart = timeStart - (period * bollingerBarTimeLengthInMinutes * 60 * 1000 * 1000);
+
+  loadPubTrades(exchange, symbol, lookbackStart, timeEnd);
+  integer lookbackStartIndex = findTransactionIndexAtTime(lookbackStart);
+  integer startIndex = findTransactionIndexAtTime(timeStart);
+  integer endIndex = findTransactionIndexAtTime(timeEnd + 1);
+  resetBollingerBands(exchange, symbol, typeStepSymbol, period, deviation);
+  if (startIndex >= endIndex || warmUpBollingerBands(lookbackStartIndex, startIndex) == false)
+  {
+    print("Not enough transactions to precompute the bands from " + startDateTime + " to " + endDateTime);
+    return;
+  }
+
+  clearBandSeries(bandSeriesKeyOf(exchange, symbol, period, deviation, bollingerBarTimeLengthInMinutes, timeStart, timeEnd));
+  recordBandSeries(0);
+  // the last transaction closes the backtest without updating the bands
+  for (integer i = startIndex; i < endIndex - 1; i++)
+  {
+    if (barBuilderAddTrade(tradeTimeColumn[i], tradePriceColumn[i], tradeAmountColumn[i]) == true)
+    {
+      updateBollingerBandValues();
+      recordBandSeries(tradeTimeColumn[i]);
+    }
+  }
+  isBandSeriesComplete = true;
+  print(toString(sizeof(bandSeriesCloseTime)) + " of bands are precomputed.");
+}
+
+/* Testing the transaction at the backtest cursor with the bollinger bands, the stop-loss is stepped by backTestTick on every transaction
+  @ prototype
+      boolean bollingerBandsBackTestSignal(integer tradeTime, float tradePrice)
+  @ params
+      tradeTime: the time stamp of the transaction
+      tradePrice: the price of the transaction
+  @ return
+      true if a signal order is placed, false if not */
+boolean bollingerBandsBackTestSignal(integer tradeTime, float tradePrice)
+{
+  float amount;
+
+  // Update bollinger bands when the transaction closes a time bar
+  boolean isBarClosed = false;
+  if (isBandSeriesUsed == true)
+  {
+    isBarClosed = nextBandSeriesValues(tradeTime);
+  }
+  else
+  {
+    if (barBuilderAddTrade(tradeTime, tradePrice, tradeAmountColumn[backTestCursor]) == true)
+    {
+      // print("----------------------------------------");
+      // print("SMA input added : " + toString(closedBarClose) + "  Time:" + timeToString(closedBarTime, "yyyy-MM-dd hh:mm:ss"));
+      // print("Old SMA: " + toString(bollingerSMA));
+      updateBollingerBandValues();
+      recordBandSeries(tradeTime);
+      isBarClosed = true;
+    }
+  }
+  if (isBarClosed == true)
+  {
+
+    setLineName("middle");
+    setLineColor("grey");
+    drawLine(tradeTime, bollingerSMA);
+
+    if (bollingerUpperBand < unreachablePrice)
+    {
+      setLineName("uppper");
+      setLineColor("#0095fd");
+      drawLine(tradeTime, bollingerUpperBand);
+
+      setLineName("lower");
+      setLineColor("#fd4700");
+      drawLine(tradeTime, bollingerLowerBand);
+    }
+    // print("New SMA :" + toString(bollingerSMA));
+  }
+  if (bollingerBarTimeLengthInMinutes > 50 && ((backTestCursor+1) % 10) == 0)   // keep the band lines visible on long bars
+  {
+    setLineName("middle");
+    setLineColor("grey");
+    drawLine(tradeTime, bollingerSMA);
+
+    if (bollingerUpperBand < unreachablePrice)
+    {
+      setLineName("uppper");
+      setLineColor("#0095fd");
+      drawLine(tradeTime, bollingerUpperBand);
+
+      setLineName("lower");
+      setLineColor("#fd4700");
+      drawLine(tradeTime, bollingerLowerBand);
+    }
+  }
+  
+  // print(timeToString(tradeTime, "yyyy-MM-dd hh:mm:ss"));
+
+  if (tradePrice > bollingerUpperBand)
+  {
+    if (positionActionOf(positionState, sellSignalEvent) == sellOrderAction)
+    {
+      // draw sell point on the price line(graph)
+      drawPoint(tradeTime, tradePrice, true, "sell");
+      setLineName("direction");
+      // draw the profit or loss line
+      if (tradePrice > lastOwnOrderPrice)
+      {          
+        setLineColor("green");
+      }
+      else
+      {
+        setLineColor("red");
+      }
+      drawLine(tradeTime, tradePrice);   
+      // Sell order notification on console
+      print("--- Market sell ordered : "+ toString(positionVolume) + "( price- " + toString(tradePrice) + ", time- " + timeToString(tradeTime, "yyyy-MM-dd hh:mm:ss") + " )");
+      // Updating last own order price
+      lastOwnOrderPrice = tradePrice;
+      amount = tradePrice * positionVolume;
+      sellTotal += amount;
+      sellCount ++;
+      // print(".       sell total is " + toString(sellTotal));
+      positionState = nextPositionState(positionState, sellSignalEvent);
+      resetStopLossLevel();
+      return true;
+    }
+  }
+  if (tradePrice < bollingerLowerBand)
+  {
+    if (positionActionOf(positionState, buySignalEvent) == buyOrderAction)
+    {
+      // draw buy point on the price line(graph)
+      drawPoint(tradeTime, tradePrice, false, "buy");
+      setLineName("direction");
+      // draw the profit or loss line
+      if (tradePrice > lastOwnOrderPrice)
+      {
+        setLineColor("green");
+      }
+      else
+      {
+        setLineColor("red");
+      }
+      drawLine(tradeTime, tradePrice);   
+      print("--- Market buy ordered : "+ toString(positionVolume) + "( price- " + toString(tradePrice) + ", time- " + timeToString(tradeTime, "yyyy-MM-dd hh:mm:ss") + " )");
+      lastOwnOrderPrice = tradePrice;
+      amount = tradePrice * positionVolume;
+      buyTotal += amount;
+      buyCount ++;  
+      // print(".       buy total is " + toString(buyTotal));
+      positionState = nextPositionState(positionState, buySignalEvent);
+      resetStopLossLevel();
+      return true;
+    }
+  }
+  // print("SMA :" + toString(bollingerSMA));
+  // print("bollingerUpperBand :" + toString(bollingerUpperBand));
+  // print("bollingerLowerBand :" + toString(bollingerLowerBand));  
+  return false;
+}
+
+/* Price above which a backtest transaction changes the bollinger state
+  @ prototype
+      float bollingerUpperEventLevel()
+  @ return
+      the upper band for a sell signal, the stop limit of a short position when it is lower, the best price of a long trailing stop, unreachablePrice if nothing can happen */
+float bollingerUpperEventLevel()
+{
+  float level = unreachablePrice;
+  integer stopAction = noOrderAction;
+  if (isStopLossRunning == true)
+  {
+    stopAction = positionActionOf(positionState, stopLossEvent);
+  }
+
+  if (positionActionOf(positionState, sellSignalEvent) == sellOrderAction)
+  {
+    level = bollingerUpperBand;
+  }
+  // the stop limit of the short position, inside the band too
+  if (stopAction == buyOrderAction && stopLossLevel < level)
+  {
+    level = stopLossLevel;
+  }
+  // a new high moves the trailing stop of the long position
+  if (stopAction == sellOrderAction && trailingStopPip > 0.0 && lockedPriceForProfit < level)
+  {
+    level = lockedPriceForProfit;
+  }
+  return level;
+}
+
+/* Price below which a backtest transaction changes the bollinger state
+  @ prototype
+      float bollingerLowerEventLevel()
+  @ return
+      the lower band for a buy signal, the stop limit of a long position when it is higher, the best price of a short trailing stop, -1.0 if nothing can happen */
+float bollingerLowerEventLevel()
+{
+  float level = -1.0;
+  integer stopAction = noOrderAction;
+  if (isStopLossRunning == true)
+  {
+    stopAction = positionActionOf(positionState, stopLossEvent);
+  }
+
+  if (positionActionOf(positionState, buySignalEvent) == buyOrderAction)
+  {
+    level = bollingerLowerBand;
+  }
+  // the stop limit of the long position, inside the band too
+  if (stopAction == sellOrderAction && stopLossLevel > level)
+  {
+    level = stopLossLevel;
+  }
+  // a new low moves the trailing stop of the short position
+  if (stopAction == buyOrderAction && trailingStopPip > 0.0 && lockedPriceForProfit > level)
+  {
+    level = lockedPriceForProfit;
+  }
+  return level;
+}
+
+/* Jumping over the backtest transactions which can't close a bar, cross a band or a stop limit
+  @ prototype
+      void skipQuietBollingerTrades()
+  @ return
+      void */
+void skipQuietBollingerTrades()
+{
+  // the last transaction closes the backtest, it's never skipped
+  integer eventIndex = backTestEndIndex - 1;
+  integer closeIndex = eventIndex;
+
+  if (isBackTestEventSkipping == false || backTestCursor >= eventIndex)
+    return;
+  updatePriceTree();
+
+  // the next bar close
+  if (isBandSeriesUsed == true)
+  {
+    if (bandSeriesCursor + 1 < sizeof(bandSeriesCloseTime))
+    {
+      closeIndex = findTransactionIndexAtTime(bandSeriesCloseTime[bandSeriesCursor + 1]);
+    }
+  }
+  else
+  {
+    if (barBuilderOpenTime < 0)
+      return;
+    closeIndex = findTransactionIndexAtTime(barBuilderOpenTime + barBuilderLength);
+  }
+  if (closeIndex < eventIndex)
+  {
+    eventIndex = closeIndex;
+  }
+
+  // the next band or stop limit crossing before it
+  eventIndex = findFirstTradeAbove(backTestCursor, eventIndex, bollingerUpperEventLevel());
+  eventIndex = findFirstTradeBelow(backTestCursor, eventIndex, bollingerLowerEventLevel());
+  if (eventIndex <= backTestCursor)
+    return;
+
+  // the skipped transactions still build the current bar
+  if (isBandSeriesUsed == false)
+  {
+    barBuilderSkipTrades(backTestCursor, eventIndex);
+  }
+  lastPrice = tradePriceColumn[eventIndex - 1];
+  backTestCursor = eventIndex;
+}
+
+/* Bollinger Bands parameter sweep
+
+  =====================================================================================
+
+  Runs every combination of the given periods, deviations, timeframes and stop-loss pips over one replay of the trades.
+  Each combination keeps its own bands and position state, so fifty combinations cost about one replay instead of fifty backtests.
+  The SMA and the standard deviation only depend on the timeframe and the period, they are computed once per bar for a band group
+  and every deviation of the group only costs one multiply-add per bar, so sweeping the deviation is nearly free.
+  Every timeframe keeps the prefix sums and the prefix sums of squares of its bar closes,
+  so the SMA and the standard deviation of any period come from two subtractions and sweeping the period is nearly free too.
+  The sums restart every windowReanchorInterval bars around the first close of the block, so they stay small on long ranges,
+  and a window over several blocks adds up the differences of each block around the anchor of the last one.
+  Nothing is ordered or drawn, the result is a table of the combinations ranked by profit.
+
+  Usage :
+  -----------------
+    integer periods[];
+    periods >> 20;
+    periods >> 100;
+    float deviations[];
+    deviations >> 2.0;
+    deviations >> 2.5;
+    string timeframes[];
+    timeframes >> "1m";
+    timeframes >> "5m";
+    float stopLossPips[];
+    stopLossPips >> 0.0;     // 0.0 means no stop-loss
+    stopLossPips >> 0.008;
+    bollingerBandsSweep("Centrabit", "LTC/BTC", periods, deviations, timeframes, stopLossPips, 1.0, "2022-11-21 00:00:00", "2022-11-25 20:00:00");
+
+    bollingerBandsDeviationSweep("Centrabit", "LTC/BTC", 100, deviations, "1m", 0.008, 1.0, "2022-11-21 00:00:00", "2022-11-25 20:00:00");
+    Sweeps only the deviation, all the combinations share one SMA and one standard deviation.
+
+    float volumes[];
+    volumes >> 0.5;
+    volumes >> 1.0;
+    bollingerBandsStopLossSweep("Centrabit", "LTC/BTC", 100, 2.0, "1m", stopLossPips, volumes, "2022-11-21 00:00:00", "2022-11-25 20:00:00");
+    Sweeps only the stop-loss and the volume over the precomputed bands of the range, the bands are computed by the first call
+    and every next call with the same bands only runs the signals.
+
+  ===================================================================================== */
+
+// Bar streams of the sweep, one per timeframe
+string sweepBarSymbol[];
+integer sweepBarLength[];
+integer sweepBarOpenTime[];
+float sweepBarClose[];
+integer sweepBarCount[];           // closed bar count
+integer sweepPrefixOffset[];       // the prefix sums of all bar streams are stored one after another in sweepPrefixSum/sweepPrefixSquaredSum
+integer sweepAnchorOffset[];       // the block anchors of all bar streams are stored one after another in sweepBlockAnchor
+float sweepBlockAnchor[];          // the first bar close of a block of windowReanchorInterval bars, the sums of the block are accumulated around it
+float sweepPrefixSum[];            // sweepPrefixSum[offset + n] is the sum of (close - anchor) from the first bar of the block to the n-th bar
+float sweepPrefixSquaredSum[];     // sweepPrefixSquaredSum[offset + n] is the sum of (close - anchor)^2 from the first bar of the block to the n-th bar
+
+// Band groups of the sweep, one per timeframe and period
+integer sweepGroupTimeframe[];     // index of the bar stream
+integer sweepGroupPeriod[];
+float sweepGroupSMA[];
+float sweepGroupStdDev[];
+
+// Settings and states of the sweep, one per combination
+integer sweepGroup[];              // index of the band group
+float sweepDeviation[];
+float sweepStopLossPip[];
+float sweepOrderVolume[];          // amount of every order of the combination
+float sweepUpperBand[];            // unreachablePrice until the timeframe closes a whole period of bars
+float sweepLowerBand[];            // -1.0 until the timeframe closes a whole period of bars
+integer sweepEventIndex[];         // next transaction which can change the state of the combination, -1 to search it again
+
+integer sweepPositionState[];      // state of the position state machine
+float sweepLastOrderPrice[];
+float sweepBuyTotal[];
+integer sweepBuyCount[];
+float sweepSellTotal[];
+integer sweepSellCount[];
+
+/* Emptying the bar streams and the combinations of the sweep
+  @ prototype
+      void clearSweep()
+  @ return
+      void */
+void clearSweep()
+{
+  string emptyStrings[];
+  integer emptyIntegers[];
+  float emptyFloats[];
+
+  sweepBarSymbol = emptyStrings;
+  sweepBarLength = emptyIntegers;
+  sweepBarOpenTime = emptyIntegers;
+  sweepBarClose = emptyFloats;
+  sweepBarCount = emptyIntegers;
+  sweepPrefixOffset = emptyIntegers;
+  sweepAnchorOffset = emptyIntegers;
+  sweepBlockAnchor = emptyFloats;
+  sweepPrefixSum = emptyFloats;
+  sweepPrefixSquaredSum = emptyFloats;
+
+  sweepGroupTimeframe = emptyIntegers;
+  sweepGroupPeriod = emptyIntegers;
+  sweepGroupSMA = emptyFloats;
+  sweepGroupStdDev = emptyFloats;
+
+  sweepGroup = emptyIntegers;
+  sweepDeviation = emptyFloats;
+  sweepStopLossPip = emptyFloats;
+  sweepOrderVolume = emptyFloats;
+  sweepUpperBand = emptyFloats;
+  sweepLowerBand = emptyFloats;
+  sweepEventIndex = emptyIntegers;
+
+  sweepPositionState = emptyIntegers;
+  sweepLastOrderPrice = emptyFloats;
+  sweepBuyTotal = emptyFloats;
+  sweepBuyCount = emptyIntegers;
+  sweepSellTotal = emptyFloats;
+  sweepSellCount = emptyIntegers;
+}
+
+/* Finding the band group of a timeframe and a period, the group is added if it doesn't exist yet
+  @ prototype
+      integer findSweepGroup(integer timeframe, integer period)
+  @ params
+      timeframe: index of the bar stream
+      period: period used to calculate SMA
+  @ return
+      index of the band group */
+integer findSweepGroup(integer timeframe, integer period)
+{
+  integer groupCount = sizeof(sweepGroupPeriod);
+  for (integer g = 0; g < groupCount; g++)
+  {
+    if (sweepGroupTimeframe[g] == timeframe && sweepGroupPeriod[g] == period)
+      return g;
+  }
+
+  sweepGroupTimeframe >> timeframe;
+  sweepGroupPeriod >> period;
+  sweepGroupSMA >> 0.0;
+  sweepGroupStdDev >> 0.0;
+  return groupCount;
+}
+
+/* Adding a combination to the sweep
+  @ prototype
+      void addSweepCombination(integer timeframe, integer period, float deviation, float stopLossPip, float volume)
+  @ params
+      timeframe: index of the bar stream
+      period: period used to calculate SMA
+      deviation: deviation float number
+      stopLossPip: stop-loss pip, 0.0 disables the stop-loss
+      volume: amount of trading(buy or sell) at once
+  @ return
+      void */
+void addSweepCombination(integer timeframe, integer period, float deviation, float stopLossPip, float volume)
+{
+  sweepGroup >> findSweepGroup(timeframe, period);
+  sweepDeviation >> deviation;
+  sweepStopLossPip >> stopLossPip;
+  sweepOrderVolume >> volume;
+  // no signal before the bands are computed from a whole period of closed bars
+  sweepUpperBand >> unreachablePrice;
+  sweepLowerBand >> -1.0;
+  sweepEventIndex >> -1;
+
+  sweepPositionState >> positionFlat;
+  sweepLastOrderPrice >> 0.0;
+  sweepBuyTotal >> 0.0;
+  sweepBuyCount >> 0;
+  sweepSellTotal >> 0.0;
+  sweepSellCount >> 0;
+}
+
+/* Adding the prefix sums of a bar stream
+  @ prototype
+      void addSweepPrefixSums(integer maxBarCount)
+  @ params
+      maxBarCount: maximum count of bars the stream can close
+  @ return
+      void */
+void addSweepPrefixSums(integer maxBarCount)
+{
+  sweepBarCount >> 0;
+  sweepPrefixOffset >> sizeof(sweepPrefixSum);
+  sweepAnchorOffset >> sizeof(sweepBlockAnchor);
+  for (integer i = 0; i <= maxBarCount; i++)
+  {
+    sweepPrefixSum >> 0.0;
+    sweepPrefixSquaredSum >> 0.0;
+  }
+  for (integer b = 0; b <= maxBarCount / windowReanchorInterval; b++)
+  {
+    sweepBlockAnchor >> 0.0;
+  }
+}
+
+/* Appending a bar close to the prefix sums of a bar stream
+  @ prototype
+      void sweepPushBarClose(integer t, float price)
+  @ params
+      t: index of the bar stream
+      price: the close price of the bar
+  @ return
+      void */
+void sweepPushBarClose(integer t, float price)
+{
+  integer offset = sweepPrefixOffset[t];
+  integer count = sweepBarCount[t];
+  integer anchorIndex = sweepAnchorOffset[t] + (count / windowReanchorInterval);
+
+  float previousSum = sweepPrefixSum[offset + count];
+  float previousSquaredSum = sweepPrefixSquaredSum[offset + count];
+
+  // the first bar of a block starts its sums again around its own close
+  if (count % windowReanchorInterval == 0)
+  {
+    sweepBlockAnchor[anchorIndex] = price;
+    previousSum = 0.0;
+    previousSquaredSum = 0.0;
+  }
+  float diff = price - sweepBlockAnchor[anchorIndex];
+  sweepPrefixSum[offset + count + 1] = previousSum + diff;
+  sweepPrefixSquaredSum[offset + count + 1] = previousSquaredSum + (diff * diff);
+  sweepBarCount[t] = count + 1;
+}
+
+/* Computing the SMA and the standard deviation of a band group at the last closed bar from the prefix sums
+  @ prototype
+      void sweepUpdateGroupStats(integer g)
+  @ params
+      g: index of the band group, its timeframe must have closed at least a period of bars
+  @ return
+      void */
+void sweepUpdateGroupStats(integer g)
+{
+  integer t = sweepGroupTimeframe[g];
+  integer offset = sweepPrefixOffset[t];
+  integer count = sweepBarCount[t];
+  integer length = sweepGroupPeriod[g];
+
+  // the differences of every block of the window are moved to the anchor of the last block
+  float anchor = sweepBlockAnchor[sweepAnchorOffset[t] + ((count - 1) / windowReanchorInterval)];
+  float sum = 0.0;
+  float squaredSum = 0.0;
+  float blockSum;
+  float blockSquaredSum;
+  float shift;
+  integer blockStart;
+  integer start;
+  integer end = count;
+  while (end > count - length)
+  {
+    blockStart = (end - 1) - ((end - 1) % windowReanchorInterval);
+    start = blockStart;
+    if (start < count - length)
+    {
+      start = count - length;
+    }
+    blockSum = sweepPrefixSum[offset + end];
+    blockSquaredSum = sweepPrefixSquaredSum[offset + end];
+    if (start > blockStart)
+    {
+      blockSum -= sweepPrefixSum[offset + start];
+      blockSquaredSum -= sweepPrefixSquaredSum[offset + start];
+    }
+    shift = sweepBlockAnchor[sweepAnchorOffset[t] + (blockStart / windowReanchorInterval)] - anchor;
+    sum += blockSum + toFloat(end - start) * shift;
+    squaredSum += blockSquaredSum + (2.0 * shift * blockSum) + (toFloat(end - start) * shift * shift);
+    end = start;
+  }
+
+  float meanDiff = sum / toFloat(length);
+  float variance = (squaredSum / toFloat(length)) - (meanDiff * meanDiff);
+  if (variance < 0.0)
+  {
+    variance = 0.0;
+  }
+  sweepGroupSMA[g] = anchor + meanDiff;
+  sweepGroupStdDev[g] = sqrt(variance);
+}
+
+/* Refreshing the bands of every combination of a band group, one multiply-add per deviation
+  @ prototype
+      void sweepUpdateGroupBands(integer g)
+  @ params
+      g: index of the band group
+  @ return
+      void */
+void sweepUpdateGroupBands(integer g)
+{
+  float sma = sweepGroupSMA[g];
+  float stdev = sweepGroupStdDev[g];
+  for (integer c = 0; c < sizeof(sweepGroup); c++)
+  {
+    if (sweepGroup[c] == g)
+    {
+      sweepUpperBand[c] = calcBollingerUpperBand(sma, stdev, sweepDeviation[c]);
+      sweepLowerBand[c] = calcBollingerLowerBand(sma, stdev, sweepDeviation[c]);
+      sweepEventIndex[c] = -1;
+    }
+  }
+}
+
+/* Testing a transaction with the state of a combination, same rules as bollingerBandsBackTestSignal
+  @ prototype
+      void sweepTestTrade(integer c, float price)
+  @ params
+      c: index of the combination
+      price: the transaction price
+  @ return
+      void */
+void sweepTestTrade(integer c, float price)
+{
+  integer state = sweepPositionState[c];
+  if (price > sweepUpperBand[c] && positionActionOf(state, sellSignalEvent) == sellOrderAction)
+  {
+    sweepLastOrderPrice[c] = price;
+    sweepSellTotal[c] = sweepSellTotal[c] + (price * sweepOrderVolume[c]);
+    sweepSellCount[c] = sweepSellCount[c] + 1;
+    sweepPositionState[c] = nextPositionState(state, sellSignalEvent);
+    return;
+  }
+  if (price < sweepLowerBand[c] && positionActionOf(state, buySignalEvent) == buyOrderAction)
+  {
+    sweepLastOrderPrice[c] = price;
+    sweepBuyTotal[c] = sweepBuyTotal[c] + (price * sweepOrderVolume[c]);
+    sweepBuyCount[c] = sweepBuyCount[c] + 1;
+    sweepPositionState[c] = nextPositionState(state, buySignalEvent);
+    return;
+  }
+  if (sweepStopLossPip[c] <= 0.0)
+    return;
+
+  // the stop limit is checked on every transaction, inside the bands too
+  if (positionActionOf(state, stopLossEvent) == buyOrderAction && price > sweepLastOrderPrice[c] * (1.0 + sweepStopLossPip[c]))
+  {
+    sweepBuyTotal[c] = sweepBuyTotal[c] + (price * sweepOrderVolume[c]);
+    sweepBuyCount[c] = sweepBuyCount[c] + 1;
+    sweepPositionState[c] = nextPositionState(state, stopLossEvent);
+    return;
+  }
+  if (positionActionOf(state, stopLossEvent) == sellOrderAction && price < sweepLastOrderPrice[c] * (1.0 - sweepStopLossPip[c]))
+  {
+    sweepSellTotal[c] = sweepSellTotal[c] + (price * sweepOrderVolume[c]);
+    sweepSellCount[c] = sweepSellCount[c] + 1;
+    sweepPositionState[c] = nextPositionState(state, stopLossEvent);
+  }
+}
+
+/* Searching the next transaction which can change the state of a combination with its current bands
+  Between two events sweepTestTrade changes nothing, the stop-loss exits are found by findStopLossTrade.
+  @ prototype
+      integer sweepFindNextEvent(integer c, integer from, integer to)
+  @ params
+      c: index of the combination
+      from: index of the first searched transaction
+      to: index after the last searched transaction
+  @ return
+      index of the event transaction, to if there is none */
+integer sweepFindNextEvent(integer c, integer from, integer to)
+{
+  integer eventIndex = to;
+  integer state = sweepPositionState[c];
+  integer stopAction = noOrderAction;
+
+  if (sweepStopLossPip[c] > 0.0)
+  {
+    stopAction = positionActionOf(state, stopLossEvent);
+  }
+
+  // crossing the bands
+  if (positionActionOf(state, sellSignalEvent) == sellOrderAction)
+  {
+    eventIndex = findFirstTradeAbove(from, eventIndex, sweepUpperBand[c]);
+  }
+  if (positionActionOf(state, buySignalEvent) == buyOrderAction)
+  {
+    eventIndex = findFirstTradeBelow(from, eventIndex, sweepLowerBand[c]);
+  }
+
+  // crossing the stop limit, inside the bands too
+  integer stopIndex = to;
+  if (stopAction == buyOrderAction)
+  {
+    stopIndex = findStopLossTrade(from, sweepLastOrderPrice[c] * (1.0 + sweepStopLossPip[c]), positionShort);
+  }
+  if (stopAction == sellOrderAction)
+  {
+    stopIndex = findStopLossTrade(from, sweepLastOrderPrice[c] * (1.0 - sweepStopLossPip[c]), positionLong);
+  }
+  if (stopIndex < eventIndex)
+  {
+    eventIndex = stopIndex;
+  }
+  return eventIndex;
+}
+
+/* Closing the position left open at the end of the sweep, same as finishBackTest
+  @ prototype
+      void sweepCloseOpenPosition(integer c, float price)
+  @ params
+      c: index of the combination
+      price: the last transaction price
+  @ return
+      void */
+void sweepCloseOpenPosition(integer c, float price)
+{
+  sweepPositionState[c] = nextPositionState(sweepPositionState[c], finalCloseEvent);
+  if (sweepBuyCount[c] < sweepSellCount[c])
+  {
+    sweepBuyTotal[c] = sweepBuyTotal[c] + (price * sweepOrderVolume[c]);
+    sweepBuyCount[c] = sweepBuyCount[c] + 1;
+  }
+  if (sweepSellCount[c] < sweepBuyCount[c])
+  {
+    sweepSellTotal[c] = sweepSellTotal[c] + (price * sweepOrderVolume[c]);
+    sweepSellCount[c] = sweepSellCount[c] + 1;
+  }
+}
+
+/* Printing the combinations of the sweep ranked by profit
+  @ prototype
+      void printSweepResult()
+  @ return
+      void */
+void printSweepResult()
+{
+  integer count = sizeof(sweepGroup);
+  integer ranking[];
+  integer best;
+  integer swapped;
+  integer c;
+
+  for (integer i = 0; i < count; i++)
+  {
+    ranking >> i;
+  }
+  // selection sort, the combination count is small
+  for (integer j = 0; j < count; j++)
+  {
+    best = j;
+    for (integer k = j + 1; k < count; k++)
+    {
+      if (sweepSellTotal[ranking[k]] - sweepBuyTotal[ranking[k]] > sweepSellTotal[ranking[best]] - sweepBuyTotal[ranking[best]])
+      {
+        best = k;
+      }
+    }
+    swapped = ranking[j];
+    ranking[j] = ranking[best];
+    ranking[best] = swapped;
+  }
+
+  print("--------------   Sweep result   -------------------");
+  print("Rank | Period | Deviation | Timeframe | Stop loss | Volume | Trades | Profit");
+  for (integer r = 0; r < count; r++)
+  {
+    c = ranking[r];
+    print(toString(r + 1) + " | " + toString(sweepGroupPeriod[sweepGroup[c]]) + " | " + toString(sweepDeviation[c]) + " | " + sweepBarSymbol[sweepGroupTimeframe[sweepGroup[c]]] + " | " + toString(sweepStopLossPip[c]) + " | " + toString(sweepOrderVolume[c]) + " | " + toString(sweepBuyCount[c] + sweepSellCount[c]) + " | " + toString(sweepSellTotal[c] - sweepBuyTotal[c]));
+  }
+}
+
+/* Bollinger Bands parameter sweep over one replay
+  @ prototype
+      void bollingerBandsSweep(string exchange, string symbol, integer[] periods, float[] deviations, string[] typeStepSymbols, float[] stopLossPips, float volume, string startDateTime, string endDateTime)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      periods: periods used to calculate SMA
+      deviations: deviation float numbers
+      typeStepSymbols: symbol strings to represent time steps (ex: "1m", "5m", "1h"...)
+      stopLossPips: stop-loss pips, 0.0 means no stop-loss
+      volume: amount of trading(buy or sell) at once
+      startDateTime: start of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+      endDateTime: end of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+  @ return
+      none */
+void bollingerBandsSweep(string exchange, string symbol, integer[] periods, float[] deviations, string[] typeStepSymbols, float[] stopLossPips, float volume, string startDateTime, string endDateTime)
+{
+  // the sweep loads its own trades into the columns, a running backtest would lose its cursor
+  if (canStartStrategy("Bollinger Bands sweep") == false)
+    return;
+  integer timeStart = stringToTime(startDateTime, "yyyy-MM-dd hh:mm:ss");
+  integer timeEnd = stringToTime(endDateTime, "yyyy-MM-dd hh:mm:ss");
+  integer maxLookback = 0;
+  integer lookback = 0;
+  integer barTime = 0;
+  integer tradeTime = 0;
+  float tradePrice = 0.0;
+  integer p;
+  integer d;
+  integer t;
+  integer l;
+  integer g;
+  integer c;
+  integer i;
+
+  initPositionMachine();
+  clearSweep();
+
+  for (t = 0; t < sizeof(typeStepSymbols); t++)
+  {
+    sweepBarSymbol >> typeStepSymbols[t];
+    sweepBarLength >> barTimeLengthInMinutes(typeStepSymbols[t]) * 60 * 1000 * 1000;
+    sweepBarOpenTime >> -1;
+    sweepBarClose >> 0.0;
+  }
+  for (p = 0; p < sizeof(periods); p++)
+  {
+    for (d = 0; d < sizeof(deviations); d++)
+    {
+      for (t = 0; t < sizeof(typeStepSymbols); t++)
+      {
+        for (l = 0; l < sizeof(stopLossPips); l++)
+        {
+          addSweepCombination(t, periods[p], deviations[d], stopLossPips[l], volume);
+        }
+        lookback = periods[p] * sweepBarLength[t];
+        if (lookback > maxLookback)
+        {
+          maxLookback = lookback;
+        }
+      }
+    }
+  }
+  integer combinationCount = sizeof(sweepGroup);
+  integer groupCount = sizeof(sweepGroupPeriod);
+  integer barStreamCount = sizeof(sweepBarLength);
+  for (t = 0; t < barStreamCount; t++)
+  {
+    addSweepPrefixSums((timeEnd - timeStart + maxLookback) / sweepBarLength[t] + 2);
+  }
+  print("Sweeping " + toString(combinationCount) + " combinations in " + toString(groupCount) + " band groups from " + startDateTime + " to " + endDateTime + "...");
+
+  // every combination is warmed up from the longest lookback
+  loadPubTrades(exchange, symbol, timeStart - maxLookback, timeEnd);
+  integer firstIndex = findTransactionIndexAtTime(timeStart - maxLookback);
+  integer startIndex = findTransactionIndexAtTime(timeStart);
+  integer endIndex = findTransactionIndexAtTime(timeEnd + 1);
+  if (startIndex >= endIndex)
+  {
+    print("No transaction is found from " + startDateTime + " to " + endDateTime);
+    return;
+  }
+
+  updatePriceTree();
+  backTestStartedAt = getCurrentTime();
+  for (i = firstIndex; i < endIndex; i++)
+  {
+    tradeTime = tradeTimeColumn[i];
+    tradePrice = tradePriceColumn[i];
+
+    for (t = 0; t < barStreamCount; t++)
+    {
+      barTime = tradeTime - (tradeTime % sweepBarLength[t]);
+      if (sweepBarOpenTime[t] >= 0 && barTime != sweepBarOpenTime[t])
+      {
+        sweepPushBarClose(t, sweepBarClose[t]);
+        for (g = 0; g < groupCount; g++)
+        {
+          // the bands of a group are armed once its timeframe closes a whole period of bars
+          if (sweepGroupTimeframe[g] == t && sweepBarCount[t] >= sweepGroupPeriod[g])
+          {
+            sweepUpdateGroupStats(g);
+            sweepUpdateGroupBands(g);
+          }
+        }
+      }
+      sweepBarOpenTime[t] = barTime;
+      sweepBarClose[t] = tradePrice;
+    }
+
+    if (i >= startIndex)
+    {
+      for (c = 0; c < combinationCount; c++)
+      {
+        // only the transactions crossing a band or a stop limit are tested
+        if (sweepEventIndex[c] < i)
+        {
+          sweepEventIndex[c] = sweepFindNextEvent(c, i, endIndex);
+        }
+        if (sweepEventIndex[c] == i)
+        {
+          sweepTestTrade(c, tradePrice);
+          sweepEventIndex[c] = -1;
+        }
+      }
+    }
+  }
+  for (c = 0; c < combinationCount; c++)
+  {
+    sweepCloseOpenPosition(c, tradePriceColumn[endIndex - 1]);
+  }
+
+  printBackTestSpeed(endIndex - startIndex);
+  printSweepResult();
+}
+
+/* Bollinger Bands deviation sweep, all deviations share one SMA and one standard deviation
+  @ prototype
+      void bollingerBandsDeviationSweep(string exchange, string symbol, integer period, float[] deviations, string typeStepSymbol, float stopLossPip, float volume, string startDateTime, string endDateTime)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      period: period used to calculate SMA
+      deviations: deviation float numbers
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      stopLossPip: stop-loss pip, 0.0 means no stop-loss
+      volume: amount of trading(buy or sell) at once
+      startDateTime: start of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+      endDateTime: end of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+  @ return
+      none */
+void bollingerBandsDeviationSweep(string exchange, string symbol, integer period, float[] deviations, string typeStepSymbol, float stopLossPip, float volume, string startDateTime, string endDateTime)
+{
+  integer periods[];
+  string typeStepSymbols[];
+  float stopLossPips[];
+  periods >> period;
+  typeStepSymbols >> typeStepSymbol;
+  stopLossPips >> stopLossPip;
+  bollingerBandsSweep(exchange, symbol, periods, deviations, typeStepSymbols, stopLossPips, volume, startDateTime, endDateTime);
+}
+
+/* Setting the bands of the band series at a cursor to every combination of the sweep
+  @ prototype
+      void sweepSetSeriesBands(integer cursor)
+  @ params
+      cursor: index in the band series
+  @ return
+      void */
+void sweepSetSeriesBands(integer cursor)
+{
+  for (integer c = 0; c < sizeof(sweepGroup); c++)
+  {
+    sweepUpperBand[c] = bandSeriesUpper[cursor];
+    sweepLowerBand[c] = bandSeriesLower[cursor];
+    sweepEventIndex[c] = -1;
+  }
+}
+
+/* Bollinger Bands stop-loss and volume sweep over the precomputed bands
+  The bands of the range are precomputed once, the next calls with the same bands only run the signals of every combination.
+  The signals are the ones of bollingerBandsBackTest, the last transaction only closes the position.
+  @ prototype
+      void bollingerBandsStopLossSweep(string exchange, string symbol, integer period, float deviation, string typeStepSymbol, float[] stopLossPips, float[] volumes, string startDateTime, string endDateTime)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      period: period used to calculate SMA
+      deviation: deviation float number
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      stopLossPips: stop-loss pips, 0.0 means no stop-loss
+      volumes: amounts of trading(buy or sell) at once
+      startDateTime: start of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+      endDateTime: end of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+  @ return
+      none */
+void bollingerBandsStopLossSweep(string exchange, string symbol, integer period, float deviation, string typeStepSymbol, float[] stopLossPips, float[] volumes, string startDateTime, string endDateTime)
+{
+  if (canStartStrategy("Bollinger Bands stop-loss sweep") == false)
+    return;
+  integer timeStart = stringToTime(startDateTime, "yyyy-MM-dd hh:mm:ss");
+  integer timeEnd = stringToTime(endDateTime, "yyyy-MM-dd hh:mm:ss");
+  string seriesKey = bandSeriesKeyOf(exchange, symbol, period, deviation, barTimeLengthInMinutes(typeStepSymbol), timeStart, timeEnd);
+  integer cursor = 0;
+  integer c;
+
+  if (isBandSeriesComplete == false || bandSeriesKey != seriesKey)
+  {
+    precomputeBollingerBands(exchange, symbol, period, deviation, typeStepSymbol, startDateTime, endDateTime);
+  }
+  else
+  {
+    print("Using precomputed bands...");
+  }
+  // precomputeBollingerBands printed why the bands are missing
+  if (isBandSeriesComplete == false || bandSeriesKey != seriesKey)
+    return;
+
+  initPositionMachine();
+  clearSweep();
+  sweepBarSymbol >> typeStepSymbol;
+  for (integer l = 0; l < sizeof(stopLossPips); l++)
+  {
+    for (integer v = 0; v < sizeof(volumes); v++)
+    {
+      addSweepCombination(0, period, deviation, stopLossPips[l], volumes[v]);
+    }
+  }
+  integer combinationCount = sizeof(sweepGroup);
+  print("Sweeping " + toString(combinationCount) + " combinations over " + toString(sizeof(bandSeriesCloseTime)) + " precomputed bands from " + startDateTime + " to " + endDateTime + "...");
+
+  // served from the trades cache filled by the precomputing
+  loadPubTrades(exchange, symbol, timeStart, timeEnd);
+  integer startIndex = findTransactionIndexAtTime(timeStart);
+  integer endIndex = findTransactionIndexAtTime(timeEnd + 1);
+
+  updatePriceTree();
+  backTestStartedAt = getCurrentTime();
+  sweepSetSeriesBands(0);
+  for (integer i = startIndex; i < endIndex - 1; i++)
+  {
+    // the bands of a bar apply from the transaction which closed it, same as nextBandSeriesValues
+    if (cursor + 1 < sizeof(bandSeriesCloseTime) && tradeTimeColumn[i] >= bandSeriesCloseTime[cursor + 1])
+    {
+      cursor ++;
+      sweepSetSeriesBands(cursor);
+    }
+    for (c = 0; c < combinationCount; c++)
+    {
+      // only the transactions crossing a band or a stop limit are tested
+      if (sweepEventIndex[c] < i)
+      {
+        sweepEventIndex[c] = sweepFindNextEvent(c, i, endIndex - 1);
+      }
+      if (sweepEventIndex[c] == i)
+      {
+        sweepTestTrade(c, tradePriceColumn[i]);
+        sweepEventIndex[c] = -1;
+      }
+    }
+  }
+  for (c = 0; c < combinationCount; c++)
+  {
+    sweepCloseOpenPosition(c, tradePriceColumn[endIndex - 1]);
+  }
+
+  printBackTestSpeed(endIndex - startIndex);
+  printSweepResult();
+}
+
+/* Starting a bar strategy
+
+  MACD, RSI and Parabolic SAR register themselves as the only strategy of the indicator pipeline and start the same way.
+  The lookback transactions are aggregated into bars pushed into the pipeline, then the bar scheduler or the backtest timer
+  is started. The strategy only resets its state before, reads its initial values and sets its running flag. */
+
+/* Pushing the bars of the lookback transactions in the trade columns into the only strategy of the pipeline
+  @ prototype
+      integer warmUpBarStrategy(integer fromIndex, integer toIndex, integer barLength)
+  @ params
+      fromIndex: index of the first lookback transaction
+      toIndex: index after the last lookback transaction
+      barLength: bar length in micro seconds
+  @ return
+      count of the closed lookback bars */
+integer warmUpBarStrategy(integer fromIndex, integer toIndex, integer barLength)
+{
+  integer stream = pipelineIndicatorStream[0];
+  barBuilderReset(barLength);
+  for (integer i=fromIndex; i<toIndex; i++)
+  {
+    if (barBuilderAddTrade(tradeTimeColumn[i], tradePriceColumn[i], tradeAmountColumn[i]) == true)
+    {
+      pipelinePushBar(stream, closedBarHigh, closedBarLow, closedBarClose);
+    }
+  }
+  return pipelineStreamBarCount[stream];
+}
+
+/* Warming up a bar strategy with the last public trades before it runs live
+  @ prototype
+      boolean warmUpLiveBarStrategy(string exchange, string symbol, integer barLength, integer lookbackBarCount, integer minimumBarCount)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      barLength: bar length in micro seconds
+      lookbackBarCount: lookback bars used for warming up
+      minimumBarCount: closed lookback bars needed to start
+  @ return
+      true: the strategy is warmed up, the charts and the traded symbol are set
+      false: not enough lookback bars are found */
+boolean warmUpLiveBarStrategy(string exchange, string symbol, integer barLength, integer lookbackBarCount, integer minimumBarCount)
+{
+  integer now = getCurrentTime();
+  integer lookbackStart = now - (lookbackBarCount * barLength);
+  loadPubTrades(exchange, symbol, lookbackStart, now);
+  if (warmUpBarStrategy(findTransactionIndexAtTime(lookbackStart), sizeof(tradeTimeColumn), barLength) < minimumBarCount)
+  {
+    print("Not enough lookback bars are found");
+    return false;
+  }
+  setChartsExchange(exchange);
+  setChartsSymbol(symbol);
+  clearCharts();
+  setChartsTime(getCurrentTime() +  30 * 24 * 60*1000000);
+
+  exchangeSetting = exchange;
+  symbolSetting = symbol;
+  lastPrice = tradePriceColumn[sizeof(tradePriceColumn)-1];
+  return true;
+}
+
+/* Starting the live bars of a warmed up bar strategy, its running flag is set before
+  @ prototype
+      void startLiveBarStrategy(integer barLength)
+  @ params
+      barLength: bar length in micro seconds
+  @ return
+      void */
+void startLiveBarStrategy(integer barLength)
+{
+  // the signals of the lookback bars are not traded
+  pendingSignalEvent = -1;
+  isBackTestMode = false;
+  updateLiveTriggers();
+
+  print("--------------   Running   -------------------");
+
+  // the bars are built from the live prices, aligned to the bar boundaries
+  barBuilderReset(barLength);
+  startBarScheduler(barLength);
+}
+
+/* Fetching the transactions of a bar strategy backtest and warming it up with the lookback ones
+  @ prototype
+      boolean warmUpBackTestBarStrategy(string exchange, string symbol, integer barLength, integer lookbackBarCount, integer minimumBarCount, string startDateTime, string endDateTime)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      barLength: bar length in micro seconds
+      lookbackBarCount: lookback bars used for warming up
+      minimumBarCount: closed lookback bars needed to start
+      startDateTime: start of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+      endDateTime: end of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+  @ return
+      true: the strategy is warmed up, the charts and the traded symbol are set
+      false: no transaction is tested or not enough lookback bars are found */
+boolean warmUpBackTestBarStrategy(string exchange, string symbol, integer barLength, integer lookbackBarCount, integer minimumBarCount, string startDateTime, string endDateTime)
+{
+  integer timeStart = stringToTime(startDateTime, "yyyy-MM-dd hh:mm:ss");
+  integer timeEnd = stringToTime(endDateTime, "yyyy-MM-dd hh:mm:ss");
+
+  integer lookbackStart = timeStart - (lookbackBarCount * barLength);
+  print("Fetching transactions from " + timeToString(lookbackStart, "yyyy-MM-dd hh:mm:ss") + " to " + endDateTime + "...");
+  integer lookbackStartIndex = loadBackTestTrades(exchange, symbol, lookbackStart, timeStart, timeEnd);
+  if (backTestStartIndex >= backTestEndIndex)
+  {
+    print("No transaction is found from " + startDateTime + " to " + endDateTime);
+    return false;
+  }
+
+  setChartsExchange(exchange);
+  setChartsSymbol(symbol);
+  clearCharts();
+
+  // the last lookback bar is closed by the first tested transaction
+  print("Preparing lookback bars...");
+  if (warmUpBarStrategy(lookbackStartIndex, backTestStartIndex, barLength) < minimumBarCount)
+  {
+    print("Not enough lookback bars are found before " + startDateTime);
+    return false;
+  }
+
+  exchangeSetting = exchange;
+  symbolSetting = symbol;
+  lastPrice = tradePriceColumn[backTestStartIndex];
+  return true;
+}
+
+/* Starting the replay of a warmed up backtest, its running flag is set before
+  @ prototype
+      void startBackTestTimer()
+  @ return
+      void */
+void startBackTestTimer()
+{
+  pendingSignalEvent = -1;
+  isBackTestMode = true;
+  isLiveTriggerOutdated = true;
+
+  print("--------------   Running   -------------------");
+
+  setChartsTime(tradeTimeColumn[backTestStartIndex] +  30 * 24 * 60*1000000);
+
+  backTestStartedAt = getCurrentTime();
+  addTimer(1);
+}
+
+/* MACD trading strategy
+
+  =====================================================================================
+
+  About MACD Indicator:
+  --------------------------------
+
+    Moving Average Convergence Divergence (MACD) is a trend-following momentum indicator
+    that shows the relationship between two exponential moving averages (EMA) of the price.
+
+    - The MACD line is the fast EMA (default 12 bars) minus the slow EMA (default 26 bars)
+    - The signal line is an EMA (default 9 bars) of the MACD line
+    - The histogram is the MACD line minus the signal line
+
+    The MACD line crossing above the signal line is a buy signal, crossing below it is a sell signal.
+
+    Every EMA is kept as a single value and updated with one multiply-add per bar close,
+      EMA = EMA + k * (close - EMA), k = 2 / (period + 1)
+    so no price history is kept. The signals come at the bar closes and the orders are placed at the next price.
+    The EMAs are the features of the indicator pipeline, the MACD runs as its only strategy.
 
   Usage :
   -----------------
 
+    live:
+      macd("Centrabit", "LTC/BTC", 12, 26, 9, "1h", 0.01);
 
     backtest:
-      backtestBollingerBands("Centrabit", "LTC/BTC", 20, 2.0, "1d", 1000, 0.01);
-      It tests Bollinger Bands trading strategy with last 1000 days data.
-      20 means SMA period, 2.0 is deviation, "1d" represents the duration of a bar.
-      Last parameter 0.01 is the amount to sell or buy at once.
+      macdBackTest("Centrabit", "LTC/BTC", 12, 26, 9, "1h", 0.01, "2022-11-01 00:00:00", "2022-11-26 00:00:00");
+      The EMAs are warmed up with macdWarmUpBarCount bars before the start.
+
+    Starting the strategy replaces the strategies added to the pipeline.
 
   ===================================================================================== */
 
-// Global values for bollinger bands 
-integer bollingerSettingPeriod = 20;
-float bollingerSettingDeviation = 2.0;
-integer bollingerBarTimeLengthInMinutes = 0;
+// Global values for MACD
+integer macdSettingFastPeriod = 12;
+integer macdSettingSlowPeriod = 26;
+integer macdSettingSignalPeriod = 9;
+integer macdBarTimeLengthInMinutes = 0;
+
+float macdSignalEMA = 0.0;
+float macdValue = 0.0;          // the MACD line
+float macdHistogram = 0.0;
+integer macdPipelineIndicator = -1;   // the MACD strategy registered in the pipeline, its EMA features keep the fast and the slow EMA
+
+/* Registering the MACD as the only strategy of the pipeline
+  @ prototype
+      void macdReset(string exchange, string symbol, string typeStepSymbol, integer fastPeriod, integer slowPeriod, integer signalPeriod)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      fastPeriod: fast EMA period
+      slowPeriod: slow EMA period
+      signalPeriod: signal EMA period
+  @ return
+      void */
+void macdReset(string exchange, string symbol, string typeStepSymbol, integer fastPeriod, integer slowPeriod, integer signalPeriod)
+{
+  macdSettingFastPeriod = fastPeriod;
+  macdSettingSlowPeriod = slowPeriod;
+  macdSettingSignalPeriod = signalPeriod;
+  clearPipeline();
+  macdPipelineIndicator = pipelineAddMACD(exchange, symbol, typeStepSymbol, fastPeriod, slowPeriod, signalPeriod);
+  resetPipeline();
+  macdSignalEMA = 0.0;
+  macdValue = 0.0;
+  macdHistogram = 0.0;
+}
+
+/* Reading the MACD lines from the pipeline
+  @ prototype
+      void readMACDValues()
+  @ return
+      void */
+void readMACDValues()
+{
+  macdHistogram = pipelineIndicatorValue[macdPipelineIndicator];
+  macdSignalEMA = pipelineIndicatorSignalEMA[macdPipelineIndicator];
+  macdValue = macdHistogram + macdSignalEMA;
+}
+
+/* Pushing the bar just closed by the bar builder into the pipeline and reading the MACD lines
+  @ prototype
+      integer updateMACDValues()
+  @ return
+      sellSignalEvent or buySignalEvent if the MACD line crossed the signal line, -1 if not */
+integer updateMACDValues()
+{
+  integer event = pipelinePushBar(pipelineIndicatorStream[macdPipelineIndicator], closedBarHigh, closedBarLow, closedBarClose);
+  readMACDValues();
+  return event;
+}
+
+/* Drawing the MACD lines
+  @ prototype
+      void drawMACDLines(integer timeStamp)
+  @ params
+      timeStamp: the time stamp of the points
+  @ return
+      void */
+void drawMACDLines(integer timeStamp)
+{
+  setLineName("macd");
+  setLineColor("#0095fd");
+  drawLine(timeStamp, macdValue);
+
+  setLineName("signal");
+  setLineColor("#fd4700");
+  drawLine(timeStamp, macdSignalEMA);
+}
+
+/* MACD strategy process
+  @ prototype
+      void macd(string exchange, string symbol, integer fastPeriod, integer slowPeriod, integer signalPeriod, string typeStepSymbol, float volume)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      fastPeriod: fast EMA period
+      slowPeriod: slow EMA period
+      signalPeriod: signal EMA period
+      typeStepSymbol: symbol string to represent time step - format : "number" + "expression letter" (ex: "1m", "3m", "5m", "15m", "1d", "3d", ... "1M", "2M"...)
+      volume: amount of trading(buy or sell) at once
+  @ return
+      void */
+void macd(string exchange, string symbol, integer fastPeriod, integer slowPeriod, integer signalPeriod, string typeStepSymbol, float volume)
+{
+  if (canStartStrategy("MACD") == false)
+    return;
+  initPositionMachine();
+  resetTradingState();
+  macdBarTimeLengthInMinutes = barTimeLengthInMinutes(typeStepSymbol);
+  integer barLength = macdBarTimeLengthInMinutes * 60 * 1000 * 1000;
+
+  macdReset(exchange, symbol, typeStepSymbol, fastPeriod, slowPeriod, signalPeriod);
+  if (warmUpLiveBarStrategy(exchange, symbol, barLength, macdWarmUpBarCount(slowPeriod, signalPeriod), 1) == false)
+    return;
+  readMACDValues();
+  print("Initial MACD :" + toString(macdValue));
+  print("Initial signal :" + toString(macdSignalEMA));
+
+  positionVolume = volume;
+  isMACDRunning = true;
+  startLiveBarStrategy(barLength);
+}
+
+/* Updating the live MACD with the bar just closed
+  @ prototype
+      void updateMACD()
+  @ return
+      void */
+void updateMACD()
+{
+  integer event = updateMACDValues();
+  print("MACD : " + toString(macdValue) + ", signal : " + toString(macdSignalEMA) + "  Time:" + timeToString(getCurrentTime(), "yyyy-MM-dd hh:mm:ss"));
+  drawMACDLines(getCurrentTime());
+  if (event >= 0)
+  {
+    pendingSignalEvent = event;
+  }
+  updateLiveTriggers();
+}
+
+/* Placing the order of a pending MACD signal at a live price
+  @ prototype
+      void macdTick(float price)
+  @ params
+      price: the new price
+  @ return
+      void */
+void macdTick(float price)
+{
+  lastPrice = price;
+  if (pendingSignalEvent < 0)
+    return;
+  executeSignalOrder(pendingSignalEvent, getCurrentTime(), price);
+  pendingSignalEvent = -1;
+}
+
+/* MACD strategy backtest
+  @ prototype
+      void macdBackTest(string exchange, string symbol, integer fastPeriod, integer slowPeriod, integer signalPeriod, string typeStepSymbol, float volume, string startDateTime, string endDateTime)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      fastPeriod: fast EMA period
+      slowPeriod: slow EMA period
+      signalPeriod: signal EMA period
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      volume: amount of trading(buy or sell) at once
+      startDateTime: start of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+      endDateTime: end of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+  @ return
+      none */
+void macdBackTest(string exchange, string symbol, integer fastPeriod, integer slowPeriod, integer signalPeriod, string typeStepSymbol, float volume, string startDateTime, string endDateTime)
+{
+  if (canStartStrategy("MACD backtest") == false)
+    return;
+  initPositionMachine();
+  resetTradingState();
+  macdBarTimeLengthInMinutes = barTimeLengthInMinutes(typeStepSymbol);
+  integer barLength = macdBarTimeLengthInMinutes * 60 * 1000 * 1000;
+
+  macdReset(exchange, symbol, typeStepSymbol, fastPeriod, slowPeriod, signalPeriod);
+  if (warmUpBackTestBarStrategy(exchange, symbol, barLength, macdWarmUpBarCount(slowPeriod, signalPeriod), 1, startDateTime, endDateTime) == false)
+    return;
+  readMACDValues();
+  print("Initial MACD :" + toString(macdValue));
+  print("Initial signal :" + toString(macdSignalEMA));
+
+  positionVolume = volume;
+  isMACDRunning = true;
+  startBackTestTimer();
+}
+
+/* RSI trading strategy
+
+  =====================================================================================
+
+  About RSI Indicator:
+  --------------------------------
+
+    The Relative Strength Index (RSI) is a momentum oscillator between 0 and 100
+    which measures the speed and the size of the recent price changes.
+
+      RSI = 100 - 100 / (1 + average gain / average loss)
+
+    The averages are smoothed with the Wilder's method over N bars (default 14),
+      average = (average * (N - 1) + change) / N
+    so only the two averages and the last close are kept, the first N changes are averaged to seed them.
+    The averages are a feature of the indicator pipeline, the RSI runs as its only strategy.
+
+    An RSI above the overbought level (default 70) says the asset may be overvalued, below the oversold level (default 30) undervalued.
+    The RSI crossing above the overbought level is a sell signal, crossing below the oversold level is a buy signal.
+    The signals come at the bar closes and the orders are placed at the next price.
+
+  Usage :
+  -----------------
+
+    live:
+      rsi("Centrabit", "LTC/BTC", 14, 70.0, 30.0, "1h", 0.01);
+
+    backtest:
+      rsiBackTest("Centrabit", "LTC/BTC", 14, 70.0, 30.0, "1h", 0.01, "2022-11-01 00:00:00", "2022-11-26 00:00:00");
+
+    Starting the strategy replaces the strategies added to the pipeline.
+
+  ===================================================================================== */
+
+// Global values for RSI
+integer rsiSettingPeriod = 14;
+float rsiSettingOverbought = 70.0;
+float rsiSettingOversold = 30.0;
+integer rsiBarTimeLengthInMinutes = 0;
+
+float rsiValue = 50.0;
+integer rsiPipelineIndicator = -1;   // the RSI strategy registered in the pipeline, its Wilder feature keeps the averages
+
+/* Registering the RSI as the only strategy of the pipeline
+  @ prototype
+      void rsiReset(string exchange, string symbol, string typeStepSymbol, integer period, float overbought, float oversold)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      period: RSI period
+      overbought: overbought level
+      oversold: oversold level
+  @ return
+      void */
+void rsiReset(string exchange, string symbol, string typeStepSymbol, integer period, float overbought, float oversold)
+{
+  rsiSettingPeriod = period;
+  rsiSettingOverbought = overbought;
+  rsiSettingOversold = oversold;
+  clearPipeline();
+  rsiPipelineIndicator = pipelineAddRSI(exchange, symbol, typeStepSymbol, period, overbought, oversold);
+  resetPipeline();
+  rsiValue = 50.0;
+}
+
+/* Reading the RSI from the pipeline
+  @ prototype
+      void readRSIValues()
+  @ return
+      void */
+void readRSIValues()
+{
+  rsiValue = pipelineIndicatorValue[rsiPipelineIndicator];
+}
+
+/* Pushing the bar just closed by the bar builder into the pipeline and reading the RSI
+  @ prototype
+      integer updateRSIValues()
+  @ return
+      sellSignalEvent or buySignalEvent if the RSI crossed a level, -1 if not */
+integer updateRSIValues()
+{
+  integer event = pipelinePushBar(pipelineIndicatorStream[rsiPipelineIndicator], closedBarHigh, closedBarLow, closedBarClose);
+  readRSIValues();
+  return event;
+}
+
+/* Drawing the RSI line
+  @ prototype
+      void drawRSILine(integer timeStamp)
+  @ params
+      timeStamp: the time stamp of the point
+  @ return
+      void */
+void drawRSILine(integer timeStamp)
+{
+  setLineName("rsi");
+  setLineColor("#0095fd");
+  drawLine(timeStamp, rsiValue);
+}
+
+/* RSI strategy process
+  @ prototype
+      void rsi(string exchange, string symbol, integer period, float overbought, float oversold, string typeStepSymbol, float volume)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      period: RSI period
+      overbought: overbought level
+      oversold: oversold level
+      typeStepSymbol: symbol string to represent time step - format : "number" + "expression letter" (ex: "1m", "3m", "5m", "15m", "1d", "3d", ... "1M", "2M"...)
+      volume: amount of trading(buy or sell) at once
+  @ return
+      void */
+void rsi(string exchange, string symbol, integer period, float overbought, float oversold, string typeStepSymbol, float volume)
+{
+  if (canStartStrategy("RSI") == false)
+    return;
+  initPositionMachine();
+  resetTradingState();
+  rsiBarTimeLengthInMinutes = barTimeLengthInMinutes(typeStepSymbol);
+  integer barLength = rsiBarTimeLengthInMinutes * 60 * 1000 * 1000;
+
+  rsiReset(exchange, symbol, typeStepSymbol, period, overbought, oversold);
+  if (warmUpLiveBarStrategy(exchange, symbol, barLength, rsiWarmUpBarCount(period), 1) == false)
+    return;
+  readRSIValues();
+  print("Initial RSI :" + toString(rsiValue));
+
+  positionVolume = volume;
+  isRSIRunning = true;
+  startLiveBarStrategy(barLength);
+}
+
+/* Updating the live RSI with the bar just closed
+  @ prototype
+      void updateRSI()
+  @ return
+      void */
+void updateRSI()
+{
+  integer event = updateRSIValues();
+  print("RSI : " + toString(rsiValue) + "  Time:" + timeToString(getCurrentTime(), "yyyy-MM-dd hh:mm:ss"));
+  drawRSILine(getCurrentTime());
+  if (event >= 0)
+  {
+    pendingSignalEvent = event;
+  }
+  updateLiveTriggers();
+}
+
+/* Placing the order of a pending RSI signal at a live price
+  @ prototype
+      void rsiTick(float price)
+  @ params
+      price: the new price
+  @ return
+      void */
+void rsiTick(float price)
+{
+  lastPrice = price;
+  if (pendingSignalEvent < 0)
+    return;
+  executeSignalOrder(pendingSignalEvent, getCurrentTime(), price);
+  pendingSignalEvent = -1;
+}
+
+/* RSI strategy backtest
+  @ prototype
+      void rsiBackTest(string exchange, string symbol, integer period, float overbought, float oversold, string typeStepSymbol, float volume, string startDateTime, string endDateTime)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      period: RSI period
+      overbought: overbought level
+      oversold: oversold level
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      volume: amount of trading(buy or sell) at once
+      startDateTime: start of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+      endDateTime: end of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+  @ return
+      none */
+void rsiBackTest(string exchange, string symbol, integer period, float overbought, float oversold, string typeStepSymbol, float volume, string startDateTime, string endDateTime)
+{
+  if (canStartStrategy("RSI backtest") == false)
+    return;
+  initPositionMachine();
+  resetTradingState();
+  rsiBarTimeLengthInMinutes = barTimeLengthInMinutes(typeStepSymbol);
+  integer barLength = rsiBarTimeLengthInMinutes * 60 * 1000 * 1000;
+
+  rsiReset(exchange, symbol, typeStepSymbol, period, overbought, oversold);
+  if (warmUpBackTestBarStrategy(exchange, symbol, barLength, rsiWarmUpBarCount(period), 1, startDateTime, endDateTime) == false)
+    return;
+  readRSIValues();
+  print("Initial RSI :" + toString(rsiValue));
+
+  positionVolume = volume;
+  isRSIRunning = true;
+  startBackTestTimer();
+}
+
+/* Parabolic SAR trading strategy
+
+  =====================================================================================
+
+  About Parabolic SAR Indicator:
+  --------------------------------
+
+    The Parabolic SAR (Stop And Reverse) is a trend-following indicator which places a trailing level below the price
+    in an uptrend and above the price in a downtrend. The level moves toward the price faster and faster:
+
+      SAR = SAR + AF * (EP - SAR)
+
+    EP is the extreme point, the highest high of the uptrend or the lowest low of the downtrend.
+    AF is the acceleration factor, it starts at the step (default 0.02) and grows by the step at every new extreme point
+    up to the maximum (default 0.2). The SAR of an uptrend never goes above the lows of the last two bars, and the SAR of
+    a downtrend never goes below their highs.
+
+    When the price crosses the SAR the trend is reversed, the SAR jumps to the extreme point and the AF is reset.
+
+    Only the SAR, the EP, the AF and the highs and lows of the last two bars are kept, they are updated once per bar close.
+    They are kept by the SAR strategy of the indicator pipeline, the Parabolic SAR runs as its only strategy.
+    Between the bar closes the SAR is the intra-bar stop level, the price crossing it places the reversal order at once,
+    so every price only costs one comparison.
+
+  Usage :
+  -----------------
+
+    live:
+      parabolicSAR("Centrabit", "LTC/BTC", 0.02, 0.2, "1h", 0.01);
+
+    backtest:
+      parabolicSARBackTest("Centrabit", "LTC/BTC", 0.02, 0.2, "1h", 0.01, "2022-11-01 00:00:00", "2022-11-26 00:00:00");
+
+    Starting the strategy replaces the strategies added to the pipeline.
+
+  ===================================================================================== */
+
+// Global values for Parabolic SAR
+float sarSettingStep = 0.02;
+float sarSettingMaximum = 0.2;
+integer sarBarTimeLengthInMinutes = 0;
+
+float sarValue = 0.0;            // SAR of the bar being built
+integer sarPipelineIndicator = -1;   // the SAR strategy registered in the pipeline, it keeps the SAR, the EP and the AF
+
+/* Registering the SAR as the only strategy of the pipeline
+  @ prototype
+      void sarReset(string exchange, string symbol, string typeStepSymbol, float step, float maximum)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      step: acceleration factor step
+      maximum: maximum acceleration factor
+  @ return
+      void */
+void sarReset(string exchange, string symbol, string typeStepSymbol, float step, float maximum)
+{
+  sarSettingStep = step;
+  sarSettingMaximum = maximum;
+  clearPipeline();
+  sarPipelineIndicator = pipelineAddSAR(exchange, symbol, typeStepSymbol, step, maximum);
+  resetPipeline();
+  intraBarSellLevel = -1.0;
+  intraBarBuyLevel = unreachablePrice;
+}
+
+/* Reading the SAR from the pipeline and arming the intra-bar levels with it
+  @ prototype
+      void readSARValues()
+  @ return
+      void */
+void readSARValues()
+{
+  integer i = sarPipelineIndicator;
+  sarValue = pipelineIndicatorValue[i];
+  intraBarSellLevel = pipelineIndicatorLowerLevel[i];
+  intraBarBuyLevel = pipelineIndicatorUpperLevel[i];
+}
+
+/* Pushing the bar just closed by the bar builder into the pipeline and arming the intra-bar levels with the next SAR
+  @ prototype
+      void updateSARValues()
+  @ return
+      void */
+void updateSARValues()
+{
+  pipelinePushBar(pipelineIndicatorStream[sarPipelineIndicator], closedBarHigh, closedBarLow, closedBarClose);
+  readSARValues();
+}
+
+/* Placing the reversal order when a price crosses the intra-bar SAR level
+  The level is disarmed until the next bar close, the bar close reverses the trend itself.
+  @ prototype
+      boolean sarStopTick(integer timeStamp, float price)
+  @ params
+      timeStamp: the time stamp for the price moment
+      price: the current price
+  @ return
+      true: the level is crossed
+      false: the price is on the trend side of the SAR */
+boolean sarStopTick(integer timeStamp, float price)
+{
+  if (price < intraBarSellLevel)
+  {
+    intraBarSellLevel = -1.0;
+    executeSignalOrder(sellSignalEvent, timeStamp, price);
+    return true;
+  }
+  if (price > intraBarBuyLevel)
+  {
+    intraBarBuyLevel = unreachablePrice;
+    executeSignalOrder(buySignalEvent, timeStamp, price);
+    return true;
+  }
+  return false;
+}
+
+/* Drawing the SAR level
+  @ prototype
+      void drawSARPoint(integer timeStamp)
+  @ params
+      timeStamp: the time stamp of the point
+  @ return
+      void */
+void drawSARPoint(integer timeStamp)
+{
+  setLineName("sar");
+  setLineColor("#0095fd");
+  drawLine(timeStamp, sarValue);
+}
 
-float bollingerSMA = 100.0;
-float bollingerSTDDEV = 0.0;
-float bollingerUpperBand = 0.0;
-float bollingerLowerBand = 0.0;
+/* Parabolic SAR strategy process
+  @ prototype
+      void parabolicSAR(string exchange, string symbol, float step, float maximum, string typeStepSymbol, float volume)
+  @ params
+      exchange: exchange string
+      symbol: symbol string
+      step: acceleration factor step
+      maximum: maximum acceleration factor
+      typeStepSymbol: symbol string to represent time step - format : "number" + "expression letter" (ex: "1m", "3m", "5m", "15m", "1d", "3d", ... "1M", "2M"...)
+      volume: amount of trading(buy or sell) at once
+  @ return
+      void */
+void parabolicSAR(string exchange, string symbol, float step, float maximum, string typeStepSymbol, float volume)
+{
+  if (canStartStrategy("Parabolic SAR") == false)
+    return;
+  initPositionMachine();
+  resetTradingState();
+  sarBarTimeLengthInMinutes = barTimeLengthInMinutes(typeStepSymbol);
+  integer barLength = sarBarTimeLengthInMinutes * 60 * 1000 * 1000;
 
-float bollingerInputPriceArray[];   // In realtime mode it will be used to store all transaction and bar datas, whereas in backtest mode it will only be used for lookback bars.
-integer bollingerBackTestTickCounter = 0;  // Counting for backtest tick
+  // the first SAR comes from the first two bars
+  sarReset(exchange, symbol, typeStepSymbol, step, maximum);
+  if (warmUpLiveBarStrategy(exchange, symbol, barLength, sarWarmUpBarCount, 2) == false)
+    return;
+  readSARValues();
+  print("Initial SAR :" + toString(sarValue));
 
+  positionVolume = volume;
+  isSARRunning = true;
+  startLiveBarStrategy(barLength);
+}
 
-/* Bollinger upper bands calculation
+/* Updating the live SAR with the closed bar
   @ prototype
-      float calcBollingerUpperBand (float sma, float stdev, float k) 
-  @ params
-      sma: sma float value of the prices in a given array
-      stdev: standard deviation caculated from a given array
-      k: represents the number of standard deviations applied to the Bollinger Bands indicator.
+      void updateSAR()
   @ return
-      bollinger upper band value */
-float calcBollingerUpperBand (float sma, float stdev, float k) 
+      void */
+void updateSAR()
 {
-  return (sma + (k*stdev));
+  updateSARValues();
+  print("SAR : " + toString(sarValue) + "  Time:" + timeToString(getCurrentTime(), "yyyy-MM-dd hh:mm:ss"));
+  drawSARPoint(getCurrentTime());
+  updateLiveTriggers();
 }
 
-/* Bollinger upper bands calculation
+/* Checking a live price with the intra-bar SAR level
   @ prototype
-      float calcBollingerLowerBand (float sma, float stdev, float k) 
+      void sarTick(float price)
   @ params
-      sma: sma float value of the prices in a given array
-      stdev: standard deviation caculated from a given array
-      k: represents the number of standard deviations applied to the Bollinger Bands indicator.
+      price: the new price
   @ return
-      bollinger upper band value */
-float calcBollingerLowerBand (float sma, float stdev, float k) 
+      void */
+void sarTick(float price)
 {
-  return (sma - (k*stdev));
+  lastPrice = price;
+  sarStopTick(getCurrentTime(), price);
 }
 
-/* Bollinger Bands strategy process
+/* Parabolic SAR strategy backtest
   @ prototype
-      string bollingerBands(string exchange, string symbol, float price, integer period, float deviation, string typeStepSymbol)
+      void parabolicSARBackTest(string exchange, string symbol, float step, float maximum, string typeStepSymbol, float volume, string startDateTime, string endDateTime)
   @ params
       exchange: exchange string
       symbol: symbol string
-      price: new price
-      period: period used to calculate SMA
-      deviation: deviation float number
-      typeStepSymbol: symbol string to represent time step - format : "number" + "expression letter" (ex: "1m", "3m", "5m", "15m", "1d", "3d", ... "1M", "2M"...)
+      step: acceleration factor step
+      maximum: maximum acceleration factor
+      typeStepSymbol: symbol string to represent time step (ex: "1m", "5m", "1h"...)
+      volume: amount of trading(buy or sell) at once
+      startDateTime: start of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+      endDateTime: end of the tested range - format : "yyyy-MM-dd hh:mm:ss"
   @ return
-      signal string ("buy" or "sell") */
-void bollingerBands(string exchange, string symbol, integer period, float deviation, string typeStepSymbol, float volume)
-{  
-  bollingerBarTimeLengthInMinutes = toInteger(substring(typeStepSymbol, 0, strlength(typeStepSymbol)-1)); // 1m, 5m, 15m, 30min, 1h, 4h, 1d, 1w, 1M
-  string timeUnit = substring(typeStepSymbol, strlength(typeStepSymbol)-1, 1);
+      none */
+void parabolicSARBackTest(string exchange, string symbol, float step, float maximum, string typeStepSymbol, float volume, string startDateTime, string endDateTime)
+{
+  if (canStartStrategy("Parabolic SAR backtest") == false)
+    return;
+  initPositionMachine();
+  resetTradingState();
+  sarBarTimeLengthInMinutes = barTimeLengthInMinutes(typeStepSymbol);
+  integer barLength = sarBarTimeLengthInMinutes * 60 * 1000 * 1000;
 
-  if (timeUnit == "h")
+  // the first SAR comes from the first two bars
+  sarReset(exchange, symbol, typeStepSymbol, step, maximum);
+  if (warmUpBackTestBarStrategy(exchange, symbol, barLength, sarWarmUpBarCount, 2, startDateTime, endDateTime) == false)
+    return;
+  readSARValues();
+  print("Initial SAR :" + toString(sarValue));
+
+  positionVolume = volume;
+  isSARRunning = true;
+  startBackTestTimer();
+}
+
+/* Running the indicator pipeline
+
+  The streams of the pipeline are fed with the live prices or with the backtest transactions, and the signals of its
+  strategies are traded on the traded exchange and symbol. */
+
+/* Closing the bar being built in a stream
+  @ prototype
+      void pipelineCloseBar(integer s)
+  @ params
+      s: index of the bar stream
+  @ return
+      void */
+void pipelineCloseBar(integer s)
+{
+  integer event = pipelinePushBar(s, pipelineStreamHigh[s], pipelineStreamLow[s], pipelineStreamClose[s]);
+  if (event >= 0)
   {
-    bollingerBarTimeLengthInMinutes = bollingerBarTimeLengthInMinutes * 60;
+    pendingSignalEvent = event;
   }
-  if (timeUnit == "d")
+  isLiveTriggerOutdated = true;
+  // the lookback bars aren't printed
+  if (isPipelineRunning == true && isBackTestMode == false)
   {
-    bollingerBarTimeLengthInMinutes = bollingerBarTimeLengthInMinutes * 24 * 60;
+    print("Pipeline bar closed : " + pipelineStreamSymbol[s] + " " + toString(pipelineStreamLength[s] / 60000000) + "m, close : " + toString(pipelineStreamClose[s]) + ", true range : " + toString(pipelineStreamTrueRange[s]) + "  Time:" + timeToString(getCurrentTime(), "yyyy-MM-dd hh:mm:ss"));
   }
-  if (timeUnit == "w")
+}
+
+/* Adding a price to the bars being built in the streams of its exchange and symbol
+  @ prototype
+      void pipelineAddPrice(string exchange, string symbol, integer timeStamp, float price)
+  @ params
+      exchange: exchange string of the price
+      symbol: symbol string of the price
+      timeStamp: the time stamp of the price
+      price: the price
+  @ return
+      void */
+void pipelineAddPrice(string exchange, string symbol, integer timeStamp, float price)
+{
+  integer barTime;
+  for (integer s = 0; s < sizeof(pipelineStreamLength); s++)
   {
-    bollingerBarTimeLengthInMinutes = bollingerBarTimeLengthInMinutes * 7 * 24 * 60;
+    if (pipelineStreamExchange[s] == exchange && pipelineStreamSymbol[s] == symbol)
+    {
+      barTime = timeStamp - (timeStamp % pipelineStreamLength[s]);
+      if (pipelineStreamOpenTime[s] >= 0 && barTime == pipelineStreamOpenTime[s])
+      {
+        if (price > pipelineStreamHigh[s])
+        {
+          pipelineStreamHigh[s] = price;
+        }
+        if (price < pipelineStreamLow[s])
+        {
+          pipelineStreamLow[s] = price;
+        }
+        pipelineStreamClose[s] = price;
+      }
+      else
+      {
+        if (pipelineStreamOpenTime[s] >= 0)
+        {
+          pipelineCloseBar(s);
+        }
+        pipelineStreamOpenTime[s] = barTime;
+        pipelineStreamHigh[s] = price;
+        pipelineStreamLow[s] = price;
+        pipelineStreamClose[s] = price;
+      }
+    }
   }
-  if (timeUnit == "M")
+}
+
+/* Checking a price of the traded symbol with the signals of the pipeline strategies
+  @ prototype
+      boolean pipelineSignalTick(integer timeStamp, float price)
+  @ params
+      timeStamp: the time stamp of the price
+      price: the price
+  @ return
+      true if a signal order is placed, false if not */
+boolean pipelineSignalTick(integer timeStamp, float price)
+{
+  integer s;
+
+  // the bar close signal is placed at the price after the close
+  if (pendingSignalEvent >= 0)
   {
-    bollingerBarTimeLengthInMinutes = bollingerBarTimeLengthInMinutes * 305 * 24 * 6; // means bollingerBarTimeLengthInMinutes * 30.5 * 24 * 60
+    integer event = pendingSignalEvent;
+    pendingSignalEvent = -1;
+    if (executeSignalOrder(event, timeStamp, price) == true)
+      return true;
   }
-
-  bar lookbackBars[] = getTimeBars(exchange, symbol, 0, period, bollingerBarTimeLengthInMinutes * 60 * 1000 * 1000);
-  for (integer i=0; i<sizeof(lookbackBars); i++)
+  for (integer i = 0; i < sizeof(pipelineIndicatorKind); i++)
   {
-    bollingerInputPriceArray >> lookbackBars[i].closePrice;
+    s = pipelineIndicatorStream[i];
+    if (pipelineIndicatorKind[i] == bollingerIndicator && pipelineStreamExchange[s] == exchangeSetting && pipelineStreamSymbol[s] == symbolSetting)
+    {
+      if (price > pipelineIndicatorUpperLevel[i])
+      {
+        if (executeSignalOrder(sellSignalEvent, timeStamp, price) == true)
+          return true;
+      }
+      if (price < pipelineIndicatorLowerLevel[i])
+      {
+        if (executeSignalOrder(buySignalEvent, timeStamp, price) == true)
+          return true;
+      }
+    }
+    if (pipelineIndicatorKind[i] == sarIndicator && pipelineStreamExchange[s] == exchangeSetting && pipelineStreamSymbol[s] == symbolSetting)
+    {
+      // same as sarStopTick, the crossed level is disarmed until the next bar close
+      if (price < pipelineIndicatorLowerLevel[i])
+      {
+        pipelineIndicatorLowerLevel[i] = -1.0;
+        if (executeSignalOrder(sellSignalEvent, timeStamp, price) == true)
+          return true;
+      }
+      if (price > pipelineIndicatorUpperLevel[i])
+      {
+        pipelineIndicatorUpperLevel[i] = unreachablePrice;
+        if (executeSignalOrder(buySignalEvent, timeStamp, price) == true)
+          return true;
+      }
+    }
   }
-  setChartsExchange(exchange);
-  setChartsSymbol(symbol);
-  clearCharts();
-  setChartsTime(getCurrentTime() +  30 * 24 * 60*1000000);
-
-  // print("SMA period is " + toString(sizeof(lookbackBars)));
-
-  bollingerSMA = calcSMA(bollingerInputPriceArray);
-  bollingerSTDDEV = calcStdDev(bollingerSMA, bollingerInputPriceArray);
-  bollingerUpperBand = calcBollingerUpperBand(bollingerSMA, bollingerSTDDEV, deviation);
-  bollingerLowerBand = calcBollingerLowerBand(bollingerSMA, bollingerSTDDEV, deviation);
-
-  print("Initial SMA :" + toString(bollingerSMA));
-  print("Initial bollingerSTDDEV :" + toString(bollingerSTDDEV));
-  print("Initial bollingerUpperBand :" + toString(bollingerUpperBand));
-  print("Initial bollingerLowerBand :" + toString(bollingerLowerBand));
-
-  exchangeSetting = exchange;
-  symbolSetting = symbol;
-
-  bollingerSettingPeriod = period;
-  bollingerSettingDeviation = deviation;
-  positionVolume = volume;
-  lastPrice = lookbackBars[sizeof(lookbackBars)-1].closePrice;
-
-  isBollingerBandsRunning = true;
+  return false;
+}
 
-  print("--------------   Running   -------------------");
+/* Checking a live price of the traded symbol with the strategies of the pipeline
+  @ prototype
+      void pipelineTick(integer timeStamp, float price)
+  @ params
+      timeStamp: the time stamp of the price
+      price: the price
+  @ return
+      void */
+void pipelineTick(integer timeStamp, float price)
+{
+  lastPrice = price;
+  if (pipelineSignalTick(timeStamp, price) == true)
+    return;
 
-  addTimer(bollingerBarTimeLengthInMinutes * 60 * 1000);
+  if (isStopLossRunning == true)  // Stop-loss algo stepping
+  {
+    stopLossTick(timeStamp, price);
+  }
 }
 
-void updateBollingerBands()
+/* Handling a live price with the pipeline
+  @ prototype
+      void pipelineLivePrice(string exchange, string symbol, float price)
+  @ params
+      exchange: exchange string of the price
+      symbol: symbol string of the price
+      price: the new price
+  @ return
+      void */
+void pipelineLivePrice(string exchange, string symbol, float price)
 {
-    // print("time differ is : " + toString(timeDiffer));
-    // print("bar time length : " + toString(barTimeLength));
-    print("----------------------------------------");
-    print("SMA input added : " + toString(lastPrice) + "  Time:" + timeToString(getCurrentTime(), "yyyy-MM-dd hh:mm:ss"));
-    print("Old SMA: " + toString(bollingerSMA));
-    bollingerInputPriceArray >> lastPrice;
-    delete bollingerInputPriceArray[0];
-
-    bollingerSMA = calcSMA(bollingerInputPriceArray);
-    bollingerSTDDEV = calcStdDev(bollingerSMA, bollingerInputPriceArray);
-    bollingerUpperBand = calcBollingerUpperBand(bollingerSMA, bollingerSTDDEV, bollingerSettingDeviation);
-    bollingerLowerBand = calcBollingerLowerBand(bollingerSMA, bollingerSTDDEV, bollingerSettingDeviation);
+  integer now = getCurrentTime();
+  pipelineAddPrice(exchange, symbol, now, price);
+  if (exchange == exchangeSetting && symbol == symbolSetting)
+  {
+    pipelineTick(now, price);
+  }
+}
 
-    print("New SMA :" + toString(bollingerSMA));
-    // print("bollingerSTDDEV :" + toString(bollingerSTDDEV));
-    // print("bollingerUpperBand :" + toString(bollingerUpperBand));
-    // print("bollingerLowerBand :" + toString(bollingerLowerBand));
+/* Closing the live bars of the streams whose time is over and no price came after it
+  @ prototype
+      void pipelineWatchdog()
+  @ return
+      void */
+void pipelineWatchdog()
+{
+  integer now = getCurrentTime();
+  for (integer s = 0; s < sizeof(pipelineStreamLength); s++)
+  {
+    if (pipelineStreamOpenTime[s] >= 0 && now >= pipelineStreamOpenTime[s] + pipelineStreamLength[s])
+    {
+      pipelineCloseBar(s);
+      pipelineStreamOpenTime[s] = -1;
+    }
+  }
 }
 
-void bollingerBandsTick(float price)
+/* Indicator pipeline process
+  @ prototype
+      void pipeline(string exchange, string symbol, float volume)
+  @ params
+      exchange: the traded exchange string
+      symbol: the traded symbol string
+      volume: amount of trading(buy or sell) at once
+  @ return
+      void */
+void pipeline(string exchange, string symbol, float volume)
 {
-  lastPrice = price;
+  if (canStartStrategy("Indicator pipeline") == false)
+    return;
+  initPositionMachine();
+  resetTradingState();
+  if (sizeof(pipelineIndicatorKind) == 0)
+  {
+    print("No strategy is added to the pipeline");
+    return;
+  }
 
-  float amount;
-  if (price > bollingerUpperBand)
+  resetPipeline();
+  integer shortestLength = 0;
+  integer now = getCurrentTime();
+  integer lookbackStart;
+  boolean isWarmedUp;
+  for (integer s = 0; s < sizeof(pipelineStreamLength); s++)
   {
-    if (position == "long" || position == "flat")
+    // the transactions of a symbol warm up all its streams at once, its first stream loads them
+    isWarmedUp = false;
+    for (integer t = 0; t < s; t++)
     {
-      sell(exchangeSetting, symbolSetting, positionVolume, price, 0);
-      drawPoint(getCurrentTime(), price, true, "sell");
-      print("--- Market sell ordered : "+ toString(positionVolume) + "( price- " + toString(price) + ", time- " + timeToString(getCurrentTime(), "yyyy-MM-dd hh:mm:ss") + " )");
-      lastOwnOrderPrice = price;
-      position = "short";
-      if (position == "flat")
+      if (pipelineStreamExchange[t] == pipelineStreamExchange[s] && pipelineStreamSymbol[t] == pipelineStreamSymbol[s])
       {
-        initOpenPosition = "short";
+        isWarmedUp = true;
       }
-      positionStoppedAt = "";
-      amount = lookbackTransactions[0].price * positionVolume;
-      sellTotal += amount;
-      sellCount ++;
-      return;
     }
-  }
-  if (price < bollingerLowerBand)
-  {
-    if (position == "short" || position == "flat")
+    if (isWarmedUp == false)
     {
-      buy(exchangeSetting, symbolSetting, positionVolume, price, 0);
-      drawPoint(getCurrentTime(), price, false, "buy");
-      print("--- Market buy ordered : "+ toString(positionVolume) + "( price- " + toString(price) + ", time- " + timeToString(getCurrentTime(), "yyyy-MM-dd hh:mm:ss") + " )");
-      lastOwnOrderPrice = price;
-      position = "long";
-      if (position == "flat")
+      lookbackStart = now - pipelineLookbackLength(pipelineStreamExchange[s], pipelineStreamSymbol[s]);
+      loadPubTrades(pipelineStreamExchange[s], pipelineStreamSymbol[s], lookbackStart, now);
+      for (integer i = findTransactionIndexAtTime(lookbackStart); i < sizeof(tradeTimeColumn); i++)
       {
-        initOpenPosition = "long";
+        pipelineAddPrice(pipelineStreamExchange[s], pipelineStreamSymbol[s], tradeTimeColumn[i], tradePriceColumn[i]);
       }
-      positionStoppedAt = "";
-      amount = lookbackTransactions[0].price * positionVolume;
-      buyTotal += amount;
-      buyCount ++;  
-      return;
+    }
+    if (shortestLength == 0 || pipelineStreamLength[s] < shortestLength)
+    {
+      shortestLength = pipelineStreamLength[s];
     }
   }
-  // print("SMA :" + toString(bollingerSMA));
-  // print("bollingerUpperBand :" + toString(bollingerUpperBand));
-  // print("bollingerLowerBand :" + toString(bollingerLowerBand));
+  for (integer s = 0; s < sizeof(pipelineStreamLength); s++)
+  {
+    print("Lookback bars of " + pipelineStreamSymbol[s] + " " + toString(pipelineStreamLength[s] / 60000000) + "m : " + toString(pipelineStreamBarCount[s]));
+  }
+  setChartsExchange(exchange);
+  setChartsSymbol(symbol);
+  clearCharts();
+  setChartsTime(getCurrentTime() +  30 * 24 * 60*1000000);
 
-    setLineName("middle");
-    setLineColor("grey");
-    drawLine(getCurrentTime(), bollingerSMA);
+  exchangeSetting = exchange;
+  symbolSetting = symbol;
+  positionVolume = volume;
+  // the signals of the lookback bars are not traded
+  pendingSignalEvent = -1;
 
-    setLineName("uppper");
-    setLineColor("#293119");
-    drawLine(getCurrentTime(), bollingerUpperBand);
+  isPipelineRunning = true;
+  isBackTestMode = false;
 
-    setLineName("lower");
-    setLineColor("black");
-    drawLine(getCurrentTime(), bollingerLowerBand);
+  print("--------------   Running   -------------------");
 
-  // setLineName("price");
-  // setLineColor("pink");
-  // drawLine(getCurrentTime(), price);
+  startBarScheduler(shortestLength);
 }
 
-/* Bollinger Bands strategy backtest
+/* Indicator pipeline backtest
   @ prototype
-      string backtestBollingerBands(string exchange, string symbol, float price, integer period, float deviation, string typeStepSymbol, integer lookbackPeriod, float bidAmount)
+      void pipelineBackTest(string exchange, string symbol, float volume, string startDateTime, string endDateTime)
   @ params
       exchange: exchange string
       symbol: symbol string
-      period: period used to calculate SMA
-      deviation: deviation float number
-      typeStepSymbol: symbol string to represent time step - format : "number" + "expression letter" (ex: "1m", "3m", "5m", "15min", "1d", "3d", ... "1M", "2M"...)
-      lookbackPeriod: lookback bar count
       volume: amount of trading(buy or sell) at once
+      startDateTime: start of the tested range - format : "yyyy-MM-dd hh:mm:ss"
+      endDateTime: end of the tested range - format : "yyyy-MM-dd hh:mm:ss"
   @ return
       none */
-void bollingerBandsBackTest(string exchange, string symbol, integer period, float deviation, string typeStepSymbol, float volume, string startDateTime, string endDateTime)
-{  
-  bollingerBarTimeLengthInMinutes = toInteger(substring(typeStepSymbol, 0, strlength(typeStepSymbol)-1)); // 1m, 5m, 15m, 30min, 1h, 4h, 1d, 1w, 1M
-  string timeUnit = substring(typeStepSymbol, strlength(typeStepSymbol)-1, 1);
-
-  // print(toString(bollingerBarTimeLengthInMinutes) + " " + timeUnit);
-
-  if (timeUnit == "h")
-  {
-    bollingerBarTimeLengthInMinutes = bollingerBarTimeLengthInMinutes * 60;
-  }
-  if (timeUnit == "d")
-  {
-    bollingerBarTimeLengthInMinutes = bollingerBarTimeLengthInMinutes * 24 * 60;
-  }
-  if (timeUnit == "w")
-  {
-    bollingerBarTimeLengthInMinutes = bollingerBarTimeLengthInMinutes * 7 * 24 * 60;
-  }
-  if (timeUnit == "M")
+void pipelineBackTest(string exchange, string symbol, float volume, string startDateTime, string endDateTime)
+{
+  if (canStartStrategy("Indicator pipeline backtest") == false)
+    return;
+  initPositionMachine();
+  resetTradingState();
+  if (sizeof(pipelineIndicatorKind) == 0)
   {
-    bollingerBarTimeLengthInMinutes = bollingerBarTimeLengthInMinutes * 305 * 24 * 6; // means bollingerBarTimeLengthInMinutes * 30.5 * 24 * 60
-  }
-
-  // strinsert(strDateTime, strlength(strDateTime)-1, " 00:00:00");
-  // strinsert(strEndTime, strlength(strEndTime)-1, " 23:59:59");
-
-  integer timeStart = stringToTime(startDateTime, "yyyy-MM-dd hh:mm:ss");
-  integer timeEnd = stringToTime(endDateTime, "yyyy-MM-dd hh:mm:ss");
-  // print("Translated start date : " + toString(timeStart));
-  // print("Translated end date : " + toString(timeEnd));
-  // print("Retranslated start date : " + timeToString(timeStart, "yyyy-MM-dd hh:mm:ss"));
-  // print("Retranslated end date : " + timeToString(timeEnd, "yyyy-MM-dd hh:mm:ss"));
-
-  print("Fetching transactions from " + startDateTime + " to " + endDateTime + "...");
-  lookbackTransactions = getPubTrades(exchangeSetting, symbolSetting, timeStart, timeEnd);
-  // print("   Result : " + toString(sizeof(lookbackTransactions)) + " of transactions are fetched.");
-  // print("Started at : " + timeToString(lookbackTransactions[0].tradeTime, "yyyy-MM-dd hh:mm:ss"));
-  // print("Ended at : " + timeToString(lookbackTransactions[sizeof(lookbackTransactions)-1].tradeTime, "yyyy-MM-dd hh:mm:ss"));
-
-  // init lookback bar generating
-  print("Preparing lookback bars...");
-  timeEnd = timeStart;
-  timeStart -= (period * bollingerBarTimeLengthInMinutes * 60 * 1000 * 1000);
-  transaction tempTransactions[] = getPubTrades(exchangeSetting, symbolSetting, timeStart, timeEnd);
-  // print("   Result : " + toString(sizeof(tempTransactions)) + " of transactions are fetched.");
-  // print("     lookback started at : " + timeToString(tempTransactions[0].tradeTime, "yyyy-MM-dd hh:mm:ss"));
-  // print("     loookback ended at : " + timeToString(tempTransactions[sizeof(tempTransactions)-1].tradeTime, "yyyy-MM-dd hh:mm:ss"));
+    print("No strategy is added to the pipeline");
+    return;
+  }
+  integer timeStart = stringToTime(startDateTime, "yyyy-MM-dd hh:mm:ss");
+  integer timeEnd = stringToTime(endDateTime, "yyyy-MM-dd hh:mm:ss");
 
-  integer step = bollingerBarTimeLengthInMinutes * 2;    // one step is 30s in fetched transactions
-  integer k=0;
-  for (integer i=0; i<period; i++)
+  resetPipeline();
+  for (integer s = 0; s < sizeof(pipelineStreamLength); s++)
   {
-    bollingerInputPriceArray >> tempTransactions[k].price;
-    // print("     " + toString(i) + "st : "+ timeToString(tempTransactions[k].tradeTime, "yyyy-MM-dd hh:mm:ss") + " price : " + toString(tempTransactions[k].price));
-    k+= step;
+    if (pipelineStreamExchange[s] != exchange || pipelineStreamSymbol[s] != symbol)
+    {
+      print("The stream of " + pipelineStreamExchange[s] + " " + pipelineStreamSymbol[s] + " isn't replayed");
+    }
   }
 
-  // bar initialBars[] = getTimeBars(exchangeSetting, symbolSetting, lookbackTransactions[0].tradeTime, period, bollingerBarTimeLengthInMinutes * 60 * 1000 * 1000);
-  // for (integer i=0; i<sizeof(initialBars); i++)
-  // {
-  //   bollingerInputPriceArray >> initialBars[i].closePrice;
-  //   // print("     " + toString(i) + "st : "+ timeToString(tempTransactions[k].tradeTime, "yyyy-MM-dd hh:mm:ss") + " price : " + toString(tempTransactions[k].price));
-  // }
+  integer lookbackStart = timeStart - pipelineLookbackLength(exchange, symbol);
+  print("Fetching transactions from " + timeToString(lookbackStart, "yyyy-MM-dd hh:mm:ss") + " to " + endDateTime + "...");
+  integer lookbackStartIndex = loadBackTestTrades(exchange, symbol, lookbackStart, timeStart, timeEnd);
+  if (backTestStartIndex >= backTestEndIndex)
+  {
+    print("No transaction is found from " + startDateTime + " to " + endDateTime);
+    return;
+  }
 
   setChartsExchange(exchange);
   setChartsSymbol(symbol);
   clearCharts();
-  print("SMA period is " + toString(sizeof(bollingerInputPriceArray)));
 
-  bollingerSMA = calcSMA(bollingerInputPriceArray);
-  bollingerSTDDEV = calcStdDev(bollingerSMA, bollingerInputPriceArray);
-  bollingerUpperBand = calcBollingerUpperBand(bollingerSMA, bollingerSTDDEV, deviation);
-  bollingerLowerBand = calcBollingerLowerBand(bollingerSMA, bollingerSTDDEV, deviation);
-
-  print("Initial SMA :" + toString(bollingerSMA));
-  print("Initial bollingerSTDDEV :" + toString(bollingerSTDDEV));
-  print("Initial bollingerUpperBand :" + toString(bollingerUpperBand));
-  print("Initial bollingerLowerBand :" + toString(bollingerLowerBand));
+  // warming up the features with the lookback transactions, the last lookback bars are closed by the first tested transaction
+  print("Preparing lookback bars...");
+  isBackTestMode = true;
+  for (integer i=lookbackStartIndex; i<backTestStartIndex; i++)
+  {
+    pipelineAddPrice(exchange, symbol, tradeTimeColumn[i], tradePriceColumn[i]);
+  }
 
   exchangeSetting = exchange;
   symbolSetting = symbol;
-  print("Initial price is " + toString(lookbackTransactions[0].price));
-
-  bollingerSettingPeriod = period;
-  bollingerSettingDeviation = deviation;
   positionVolume = volume;
-  lastPrice = bollingerInputPriceArray[sizeof(bollingerInputPriceArray)-1];
+  lastPrice = tradePriceColumn[backTestStartIndex];
+  pendingSignalEvent = -1;
 
-  isBollingerBandsRunning = true;
-  isBackTestMode = true;
+  isPipelineRunning = true;
+  isLiveTriggerOutdated = true;
 
   print("--------------   Running   -------------------");
-  
-  setChartsTime(lookbackTransactions[0].tradeTime +  30 * 24 * 60*1000000);
 
+  setChartsTime(tradeTimeColumn[backTestStartIndex] +  30 * 24 * 60*1000000);
+
+  backTestStartedAt = getCurrentTime();
   addTimer(1);
 }
 
-void bollingerBandsBackTestTick()
-{
-  float amount;
+/* Backtest replay
 
-  // print(toString(sizeof(lookbackTransactions)));
-  // if all transactions are tested, finish the backtest
-  if (sizeof(lookbackTransactions) == 0)
+  Every backtest replays the loaded trade columns the same way: the trade stream is filled before the last loaded transaction
+  is tested, the last transaction closes the position and prints the result, a timer tick tests a slice of transactions and
+  the stop-loss is stepped on every transaction without a signal order.
+  The running strategy only supplies its per-bar update and its signal, only one strategy runs at once. */
+
+/* Updating the running bar strategy with the bar just closed by the bar builder
+  @ prototype
+      integer backTestBarSignal(integer closeTime)
+  @ params
+      closeTime: the time stamp of the transaction closing the bar
+  @ return
+      the signal event of the bar, -1 if there is none */
+integer backTestBarSignal(integer closeTime)
+{
+  integer event = -1;
+  if (isMACDRunning == true)
   {
-    removeTimer(1);
-    return;
+    event = updateMACDValues();
+    drawMACDLines(closeTime);
   }
-  if (sizeof(lookbackTransactions) == 1)
+  if (isRSIRunning == true)
   {
-    removeTimer(1);
+    event = updateRSIValues();
+    drawRSILine(closeTime);
+  }
+  if (isSARRunning == true)
+  {
+    updateSARValues();
+    drawSARPoint(closeTime);
+  }
+  return event;
+}
+
+/* Testing a transaction with the signal of the running strategy
+  @ prototype
+      boolean backTestSignalTick(integer tradeTime, float tradePrice, float tradeAmount)
+  @ params
+      tradeTime: the time stamp of the transaction
+      tradePrice: the price of the transaction
+      tradeAmount: the amount of the transaction
+  @ return
+      true if a signal order is placed, false if not */
+boolean backTestSignalTick(integer tradeTime, float tradePrice, float tradeAmount)
+{
+  if (isBollingerBandsRunning == true)
+    return bollingerBandsBackTestSignal(tradeTime, tradePrice);
+  if (isPipelineRunning == true)
+  {
+    pipelineAddPrice(exchangeSetting, symbolSetting, tradeTime, tradePrice);
+    return pipelineSignalTick(tradeTime, tradePrice);
+  }
 
-    if (buyCount < sellCount)
+  // the transaction closing a bar places the order of its signal
+  if (barBuilderAddTrade(tradeTime, tradePrice, tradeAmount) == true)
+  {
+    integer event = backTestBarSignal(tradeTime);
+    if (event >= 0)
     {
-      // buy(exchangeSetting, symbolSetting, positionVolume, lookbackTransactions[0].price, 0);
-      drawPoint(lookbackTransactions[0].tradeTime, lookbackTransactions[0].price, false, "buy");
-      setLineName("direction");
-      // draw the profit or loss line
-      if (lookbackTransactions[0].price > lastOwnOrderPrice)
-      {          
-        setLineColor("green");
-      }
-      else
-      {
-        setLineColor("red");
-      }
-      drawLine(lookbackTransactions[0].tradeTime, lookbackTransactions[0].price);   
-      print("--- Market buy ordered : "+ toString(positionVolume) + "( price- " + toString(lookbackTransactions[0].price) + ", time- " + timeToString(lookbackTransactions[0].tradeTime, "yyyy-MM-dd hh:mm:ss") + " )");
-      amount = lookbackTransactions[0].price * positionVolume;
-      buyTotal += amount;
-      buyCount ++;  
-      print(".       buy total is " + toString(buyTotal));
+      if (executeSignalOrder(event, tradeTime, tradePrice) == true)
+        return true;
     }
-    if (sellCount < buyCount)
-    {
-      // sell(exchangeSetting, symbolSetting, positionVolume, lookbackTransactions[0].price, 0);
-      drawPoint(lookbackTransactions[0].tradeTime, lookbackTransactions[0].price, true, "sell");
-      setLineName("direction");
-      // draw the profit or loss line
-      if (lookbackTransactions[0].price > lastOwnOrderPrice)
-      {          
-        setLineColor("green");
-      }
-      else
-      {
-        setLineColor("red");
-      }
-      drawLine(lookbackTransactions[0].tradeTime, lookbackTransactions[0].price);   
+  }
+  // the intra-bar SAR level is the signal of the Parabolic SAR
+  if (isSARRunning == true)
+    return sarStopTick(tradeTime, tradePrice);
+  return false;
+}
 
-      print("--- Market sell ordered : "+ toString(positionVolume) + "( price- " + toString(lookbackTransactions[0].price) + ", time- " + timeToString(lookbackTransactions[0].tradeTime, "yyyy-MM-dd hh:mm:ss") + " )");
-      amount = lookbackTransactions[0].price * positionVolume;
-      sellTotal += amount;
-      sellCount ++;
-      print(".       sell total is " + toString(sellTotal));
-    }
+/* Testing the transaction at the backtest cursor with the running strategy
+  @ prototype
+      void backTestTick()
+  @ return
+      void */
+void backTestTick()
+{
+  // load the next transactions of the stream before testing the last loaded one
+  if (backTestCursor == backTestEndIndex - 1)
+  {
+    tradeStreamFill();
+  }
 
-    // print(toString(bollingerBackTestTickCounter) + "times ticked");
-    print("--------------   Result   -------------------");
-    print("Total buy : " + toString(buyTotal) + " in " + toString(buyCount) );
-    print("Total sell : " + toString(sellTotal) + " in " + toString(sellCount) );
-    print("Total profit : " + toString(sellTotal-buyTotal));
+  // if all transactions are tested, finish the backtest
+  if (backTestCursor >= backTestEndIndex)
+  {
+    removeTimer(1);
     return;
   }
 
-  lastPrice = lookbackTransactions[0].price;
+  float tradePrice = tradePriceColumn[backTestCursor];
+  integer tradeTime = tradeTimeColumn[backTestCursor];
 
-  // Update bollinger bands when the step time is reached
-  integer step = bollingerBarTimeLengthInMinutes * 2;
-  if (((bollingerBackTestTickCounter+1) % step) == 0)   // Update bollinger bands
+  if (backTestCursor == backTestEndIndex - 1)
   {
-    // if (((bollingerBackTestTickCounter+1) % 10000) == 0)
-    // {
-    //   setChartsTime(lookbackTransactions[0].tradeTime +  10 * 24 * 60*1000000);
-    // }
-    // print("----------------------------------------");
-    // print("SMA input added : " + toString(lookbackTransactions[0].price) + "  Time:" + timeToString(getCurrentTime(), "yyyy-MM-dd hh:mm:ss"));
-    // print("Old SMA: " + toString(bollingerSMA));
-    bollingerInputPriceArray >> lookbackTransactions[0].price;
-    delete bollingerInputPriceArray[0];
+    // the recorded bands cover the whole tested range now
+    if (isBollingerBandsRunning == true && isBandSeriesUsed == false)
+    {
+      isBandSeriesComplete = true;
+    }
+    finishBackTest(tradeTime, tradePrice);
+    return;
+  }
 
-    bollingerSMA = calcSMA(bollingerInputPriceArray);
-    bollingerSTDDEV = calcStdDev(bollingerSMA, bollingerInputPriceArray);
-    bollingerUpperBand = calcBollingerUpperBand(bollingerSMA, bollingerSTDDEV, bollingerSettingDeviation);
-    bollingerLowerBand = calcBollingerLowerBand(bollingerSMA, bollingerSTDDEV, bollingerSettingDeviation);
+  lastPrice = tradePrice;
+  if (backTestSignalTick(tradeTime, tradePrice, tradeAmountColumn[backTestCursor]) == true)
+    return;
 
-    setLineName("middle");
-    setLineColor("grey");
-    drawLine(lookbackTransactions[0].tradeTime, bollingerSMA);
+  if (isStopLossRunning == true)  // Stop-loss algo stepping
+  {
+    stopLossTick(tradeTime, tradePrice);
+  }
+}
 
-    setLineName("uppper");
-    setLineColor("#0095fd");
-    drawLine(lookbackTransactions[0].tradeTime, bollingerUpperBand);
+/* Testing the next slice of backtest transactions in one timer tick
+  @ prototype
+      void backTestSlice()
+  @ return
+      void */
+void backTestSlice()
+{
+  integer testedCount = 0;
 
-    setLineName("lower");
-    setLineColor("#fd4700");
-    drawLine(lookbackTransactions[0].tradeTime, bollingerLowerBand);
-    // print("New SMA :" + toString(bollingerSMA));
+  // let the tick finish the backtest and remove the timer
+  if (backTestCursor >= backTestEndIndex)
+  {
+    backTestTick();
+    return;
   }
-  if (step > 100 && ((bollingerBackTestTickCounter+1) % 10) == 0)
+  // the end index can move forward while testing when the trades are streamed
+  while (backTestCursor < backTestEndIndex)
   {
-    setLineName("middle");
-    setLineColor("grey");
-    drawLine(lookbackTransactions[0].tradeTime, bollingerSMA);
-
-    setLineName("uppper");
-    setLineColor("#0095fd");
-    drawLine(lookbackTransactions[0].tradeTime, bollingerUpperBand);
+    if (backTestTradesPerTimerTick > 0 && testedCount >= backTestTradesPerTimerTick)
+      return;
+    if (isBollingerBandsRunning == true)
+    {
+      skipQuietBollingerTrades();
+    }
+    backTestTick();
+    backTestCursor ++;
+    testedCount ++;
+  }
+}
 
-    setLineName("lower");
-    setLineColor("#fd4700");
-    drawLine(lookbackTransactions[0].tradeTime, bollingerLowerBand);    
+/* Handling a live price with the running algos
+  @ prototype
+      void handleLivePrice(float price)
+  @ params
+      price: the new price
+  @ return
+      void */
+void handleLivePrice(float price)
+{
+  if (isLiveTriggerOutdated == true)
+  {
+    updateLiveTriggers();
+  }
+  // nothing can be triggered between the thresholds
+  if (price <= liveUpperTrigger && price >= liveLowerTrigger)
+  {
+    if ((isBollingerBandsRunning == true || isMACDRunning == true || isRSIRunning == true || isSARRunning == true) && isBackTestMode == false)
+    {
+      lastPrice = price;
+    }
+    return;
   }
-  
-  // print(timeToString(lookbackTransactions[bollingerBackTestTickCounter].tradeTime, "yyyy-MM-dd hh:mm:ss"));
 
-  if (lookbackTransactions[0].price > bollingerUpperBand)
+  // Bollinger bands algo stepping
+  if (isBollingerBandsRunning == true)
   {
-    if (position == "long" || position == "flat")
+    if (isBackTestMode == false)
     {
-      if (positionStoppedAt == "short")
-      {
-        return;
-      }
-      if (trailingStop(lookbackTransactions[0].price) == false)
-      {
-        // draw sell point on the price line(graph)
-        drawPoint(lookbackTransactions[0].tradeTime, lookbackTransactions[0].price, true, "sell");
-        setLineName("direction");
-        // draw the profit or loss line
-        if (lookbackTransactions[0].price > lastOwnOrderPrice)
-        {          
-          setLineColor("green");
-        }
-        else
-        {
-          setLineColor("red");
-        }
-        drawLine(lookbackTransactions[0].tradeTime, lookbackTransactions[0].price);   
-        // Sell order notification on console
-        print("--- Market sell ordered : "+ toString(positionVolume) + "( price- " + toString(lookbackTransactions[0].price) + ", time- " + timeToString(lookbackTransactions[0].tradeTime, "yyyy-MM-dd hh:mm:ss") + " )");
-        // Updating last own order price
-        lastOwnOrderPrice = lookbackTransactions[0].price;
-        if (position == "flat")
-        {
-          initOpenPosition = "short";
-        }
-        amount = lookbackTransactions[0].price * positionVolume;
-        sellTotal += amount;
-        sellCount ++;
-        // print(".       sell total is " + toString(sellTotal));
-        position = "short";
-        positionStoppedAt = "";        
-      }
-      return;
+      bollingerBandsTick(price);
     }
-    // if the position is "short"
-    if (isStopLossRunning == true && positionStoppedAt == "")  // Stop-loss algo stepping
+  }
+  // MACD algo stepping
+  if (isMACDRunning == true)
+  {
+    if (isBackTestMode == false)
     {
-      positionStoppedAt = stopLossTick(lookbackTransactions[0].tradeTime, lookbackTransactions[0].price);
-      if (positionStoppedAt != "")
-      { 
-        return;
-      }
-    }   
+      macdTick(price);
+    }
   }
-  if (lookbackTransactions[0].price < bollingerLowerBand)
+  // RSI algo stepping
+  if (isRSIRunning == true)
   {
-    if (position == "short" || position == "flat")
+    if (isBackTestMode == false)
     {
-      if (positionStoppedAt == "long")
-      {
-        return;
-      }
-      if (trailingStop(lookbackTransactions[0].price) == false)
-      {
-        // draw buy point on the price line(graph)
-        drawPoint(lookbackTransactions[0].tradeTime, lookbackTransactions[0].price, false, "buy");
-        setLineName("direction");
-        // draw the profit or loss line
-        if (lookbackTransactions[0].price > lastOwnOrderPrice)
-        {
-          setLineColor("green");
-        }
-        else
-        {
-          setLineColor("red");
-        }
-        drawLine(lookbackTransactions[0].tradeTime, lookbackTransactions[0].price);   
-        print("--- Market buy ordered : "+ toString(positionVolume) + "( price- " + toString(lookbackTransactions[0].price) + ", time- " + timeToString(lookbackTransactions[0].tradeTime, "yyyy-MM-dd hh:mm:ss") + " )");
-        lastOwnOrderPrice = lookbackTransactions[0].price;
-        if (position == "flat")
-        {
-          initOpenPosition = "long";
-        }
-        amount = lookbackTransactions[0].price * positionVolume;
-        buyTotal += amount;
-        buyCount ++;  
-        // print(".       buy total is " + toString(buyTotal));
-        position = "long";
-        positionStoppedAt = "";        
-      }
-      return;
+      rsiTick(price);
     }
-    // if the position is "short"
-    if (isStopLossRunning == true && positionStoppedAt == "")  // Stop-loss algo stepping
+  }
+  // Parabolic SAR algo stepping
+  if (isSARRunning == true)
+  {
+    if (isBackTestMode == false)
     {
-      positionStoppedAt = stopLossTick(lookbackTransactions[0].tradeTime, lookbackTransactions[0].price);
-      if (positionStoppedAt != "")
-      { 
-        return;
-      }
-    }  
+      sarTick(price);
+    }
+  }
+  // Stop-loss algo stepping
+  if (isStopLossRunning == true)
+  {
+    stopLossTick(getCurrentTime(), price);
+  }
+  updateLiveTriggers();
+}
+
+/* Tick coalescing
+
+  During bursts the prices come faster than the orders, prints and drawings of a handled tick finish.
+  With the coalescing the prices are only kept in one slot, the last, the highest and the lowest price since the last drain,
+  and a timer handles the slot once per interval. The highest and the lowest prices are handled in their arrival order,
+  so no band or stop crossing is missed, then the last price.
+  onTimedOut tells the drain timer apart by its interval, the bar boundary scheduler never arms the same interval. */
+
+boolean hasCoalescedTick = false;
+integer coalescedTickCount = 0;
+float coalescedLastPrice = 0.0;
+float coalescedHighPrice = 0.0;
+float coalescedLowPrice = 0.0;
+integer coalescedHighTick = 0;         // arrival number of the highest price in the slot
+integer coalescedLowTick = 0;          // arrival number of the lowest price in the slot
+
+/* Keeping a price in the coalescing slot
+  @ prototype
+      void coalesceTick(float price)
+  @ params
+      price: the new price
+  @ return
+      void */
+void coalesceTick(float price)
+{
+  coalescedTickCount ++;
+  coalescedLastPrice = price;
+  if (hasCoalescedTick == false || price > coalescedHighPrice)
+  {
+    coalescedHighPrice = price;
+    coalescedHighTick = coalescedTickCount;
+  }
+  if (hasCoalescedTick == false || price < coalescedLowPrice)
+  {
+    coalescedLowPrice = price;
+    coalescedLowTick = coalescedTickCount;
+  }
+  hasCoalescedTick = true;
+}
+
+/* Handling the prices kept since the last drain
+  @ prototype
+      void drainCoalescedTicks()
+  @ return
+      void */
+void drainCoalescedTicks()
+{
+  if (hasCoalescedTick == false)
+    return;
+  hasCoalescedTick = false;
+  coalescedTickCount = 0;
+
+  if (coalescedHighTick < coalescedLowTick)
+  {
+    handleLivePrice(coalescedHighPrice);
+    handleLivePrice(coalescedLowPrice);
+  }
+  else
+  {
+    handleLivePrice(coalescedLowPrice);
+    handleLivePrice(coalescedHighPrice);
+  }
+  handleLivePrice(coalescedLastPrice);
+}
+
+/* Setting the tick coalescing
+  @ prototype
+      void tickCoalescing(integer intervalInMilliseconds)
+  @ params
+      intervalInMilliseconds: drain interval, 0 disables the coalescing
+  @ return
+      void */
+void tickCoalescing(integer intervalInMilliseconds)
+{
+  if (tickCoalescingInterval > 0)
+  {
+    drainCoalescedTicks();
+    removeTimer(tickCoalescingInterval);
+  }
+  tickCoalescingInterval = intervalInMilliseconds;
+  // the scheduler moves off the drain interval before the drain timer is added
+  if (barSchedulerLength > 0)
+  {
+    armBarScheduler(getCurrentTime());
+  }
+  if (tickCoalescingInterval > 0)
+  {
+    addTimer(tickCoalescingInterval);
+  }
+}
+
+/* Live bars
+
+  The live bands are updated with the bars built from the live prices, aligned to the wall-clock bar boundaries.
+  A bar is closed by the first price after its end, or by the bar boundary scheduler if no price comes. */
+
+/* Updating the live bands with the closed bar
+  @ prototype
+      void closeLiveBar()
+  @ return
+      void */
+void closeLiveBar()
+{
+  // the prices of the closed bar are handled with its bands
+  drainCoalescedTicks();
+  if (isBollingerBandsRunning == true)
+  {
+    updateBollingerBands(closedBarClose);
+  }
+  if (isMACDRunning == true)
+  {
+    updateMACD();
+  }
+  if (isRSIRunning == true)
+  {
+    updateRSI();
+  }
+  if (isSARRunning == true)
+  {
+    updateSAR();
+  }
+}
+
+/* Adding a live price to the bar being built
+  @ prototype
+      void liveBarAddPrice(float price)
+  @ params
+      price: the new price
+  @ return
+      void */
+void liveBarAddPrice(float price)
+{
+  if (barBuilderAddTrade(getCurrentTime(), price, 0.0) == true)
+  {
+    closeLiveBar();
+  }
+}
+
+/* Closing the live bar when its time is over and no price came after it
+  @ prototype
+      void liveBarWatchdog()
+  @ return
+      void */
+void liveBarWatchdog()
+{
+  if (barBuilderCloseIfDue(getCurrentTime()) == true)
+  {
+    closeLiveBar();
   }
-  // print("SMA :" + toString(bollingerSMA));
-  // print("bollingerUpperBand :" + toString(bollingerUpperBand));
-  // print("bollingerLowerBand :" + toString(bollingerLowerBand));  
 }
 
 /* When the price changed detected
@@ -835,36 +5558,43 @@ void bollingerBandsBackTestTick()
 */
 event onLastPriceChanged(string exchange, string symbol, float amount)
 {
-  // Bollinger bands algo stepping
-  if (isBollingerBandsRunning == true)
+  if (isPipelineRunning == true && isBackTestMode == false)
   {
-    if (isBackTestMode == false)
-    {
-      bollingerBandsTick(amount);
-    }
+    pipelineLivePrice(exchange, symbol, amount);
+    return;
   }
-  // Stop-loss algo stepping
-  if (isStopLossRunning == true && positionStoppedAt == "")
+  if ((isBollingerBandsRunning == true || isMACDRunning == true || isRSIRunning == true || isSARRunning == true) && isBackTestMode == false)
+  {
+    liveBarAddPrice(amount);
+  }
+  if (tickCoalescingInterval > 0)
   {
-    positionStoppedAt = stopLossTick(getCurrentTime(), amount);
-  }    
+    coalesceTick(amount);
+    return;
+  }
+  handleLivePrice(amount);
 }
 
 event onTimedOut(integer interval) 
 {
-  if (isBollingerBandsRunning == true)
+  if (tickCoalescingInterval > 0 && interval == tickCoalescingInterval && isBackTestMode == false)
   {
-    if (isBackTestMode == false)
-    {
-      updateBollingerBands();
-    }
-    else 
+    drainCoalescedTicks();
+    return;
+  }
+  if (isBackTestMode == false)
+  {
+    if (barSchedulerTimedOut(interval) == true)
     {
-      bollingerBandsBackTestTick();
-      bollingerBackTestTickCounter ++;
-      delete lookbackTransactions[0];
+      liveBarWatchdog();
+      if (isPipelineRunning == true)
+      {
+        pipelineWatchdog();
+      }
     }
+    return;
   }
+  backTestSlice();
 }
 
 // bollingerBands("Centrabit", "LTC/BTC", 100, 2.0, "1m", 0.01);